@@ -0,0 +1,283 @@
+#ifndef SJTU_ALGORITHM_HPP
+#define SJTU_ALGORITHM_HPP
+
+#include "deque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sjtu {
+    /**
+     * algorithms over a whole deque.
+     * they run one tight loop per block through the segment iterators
+     * instead of paying iterator++ and *it checks for every element.
+     */
+
+    template<class T, class Function>
+    Function for_each(deque<T> &q, Function f) {
+        for (typename deque<T>::segment_iterator s = q.segment_begin(); s != q.segment_end(); ++s) {
+            for (T **p = s.begin(), **e = s.end(); p != e; ++p)
+                f(**p);
+        }
+        return f;
+    }
+
+    template<class T, class Function>
+    Function for_each(const deque<T> &q, Function f) {
+        for (typename deque<T>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+            for (const T *const *p = s.begin(), *const *e = s.end(); p != e; ++p)
+                f(**p);
+        }
+        return f;
+    }
+
+    /**
+     * copies every element to out, returns the iterator past the last one written.
+     */
+    template<class T, class OutputIt>
+    OutputIt copy(const deque<T> &q, OutputIt out) {
+        for (typename deque<T>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+            for (const T *const *p = s.begin(), *const *e = s.end(); p != e; ++p, ++out)
+                *out = **p;
+        }
+        return out;
+    }
+
+    /**
+     * returns the first element equal to value, or end() if there is none.
+     */
+    template<class T>
+    typename deque<T>::iterator find(deque<T> &q, const T &value) {
+        for (typename deque<T>::segment_iterator s = q.segment_begin(); s != q.segment_end(); ++s) {
+            T **b = s.begin();
+            for (T **p = b, **e = s.end(); p != e; ++p) {
+                if (**p == value)
+                    return s.at(p - b);
+            }
+        }
+        return q.end();
+    }
+
+    template<class T>
+    typename deque<T>::const_iterator find(const deque<T> &q, const T &value) {
+        for (typename deque<T>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+            const T *const *b = s.begin();
+            for (const T *const *p = b, *const *e = s.end(); p != e; ++p) {
+                if (**p == value)
+                    return s.at(p - b);
+            }
+        }
+        return q.cend();
+    }
+
+    /**
+     * folds the elements from front to back with operator+.
+     */
+    template<class T, class U>
+    U accumulate(const deque<T> &q, U init) {
+        for (typename deque<T>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+            for (const T *const *p = s.begin(), *const *e = s.end(); p != e; ++p)
+                init = init + **p;
+        }
+        return init;
+    }
+
+    template<class T, class U, class BinaryOp>
+    U accumulate(const deque<T> &q, U init, BinaryOp op) {
+        for (typename deque<T>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+            for (const T *const *p = s.begin(), *const *e = s.end(); p != e; ++p)
+                init = op(init, **p);
+        }
+        return init;
+    }
+
+    /**
+     * assigns value to every element.
+     */
+    template<class T>
+    void fill(deque<T> &q, const T &value) {
+        for (typename deque<T>::segment_iterator s = q.segment_begin(); s != q.segment_end(); ++s) {
+            for (T **p = s.begin(), **e = s.end(); p != e; ++p)
+                **p = value;
+        }
+    }
+
+    /**
+     * the machinery behind sort() and stable_sort().
+     * the element pointers are gathered block by block into one array, each thread sorts a run of it,
+     * then the runs are merged pairwise, every merge cut into independent pieces along its merge path
+     * so that all threads work in every round. the result is written back into the blocks.
+     * elements are never copied or moved, only their pointers, and the blocks keep their sizes.
+     * if comp throws, the deque is left as it was.
+     */
+    template<class T, class Compare>
+    class block_sorter {
+    private:
+        Compare comp;
+        bool stable;
+        unsigned threads;
+
+        bool less(const T *a, const T *b) const {
+            return comp(*a, *b);
+        }
+
+        /**
+         * runs f(0) ... f(tasks - 1) on up to `threads` threads, rethrowing the first exception.
+         */
+        template<class Function>
+        void parallel(size_t tasks, Function f) const {
+            std::atomic<size_t> next(0);
+            std::exception_ptr error;
+            std::mutex lock;
+            auto work = [&]() {
+                try {
+                    for (size_t i = next++; i < tasks; i = next++)
+                        f(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (!error)
+                        error = std::current_exception();
+                    next = tasks;
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (size_t i = 1; i < threads && i < tasks; ++i)
+                pool.push_back(std::thread(work));
+            work();
+            for (size_t i = 0; i < pool.size(); ++i)
+                pool[i].join();
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        /**
+         * the number of elements taken from a when d elements of merge(a, b) have been output.
+         * ties go to a, as in std::merge.
+         */
+        size_t corank(size_t d, T **a, size_t m, T **b, size_t n) const {
+            size_t lo = d > n ? d - n : 0, hi = d < m ? d : m;
+            while (true) {
+                size_t i = lo + (hi - lo) / 2, j = d - i;
+                if (i > 0 && j < n && less(b[j], a[i - 1]))
+                    hi = i - 1;
+                else if (j > 0 && i < m && !less(b[j - 1], a[i]))
+                    lo = i + 1;
+                else
+                    return i;
+            }
+        }
+
+    public:
+        block_sorter(Compare comp, bool stable, unsigned threads) : comp(comp), stable(stable), threads(threads) {
+            if (this->threads == 0)
+                this->threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        void operator()(deque<T> &q) {
+            size_t n = q.size();
+            if (n < 2)
+                return;
+
+            // begin() detaches shared blocks, so the blocks are visited here on one thread
+            std::vector<T **> seg;
+            std::vector<size_t> off;
+            std::vector<int> len;
+            size_t k = 0;
+            for (typename deque<T>::segment_iterator s = q.segment_begin(); s != q.segment_end(); ++s) {
+                seg.push_back(s.begin());
+                off.push_back(k);
+                len.push_back(s.size());
+                k += s.size();
+            }
+
+            std::vector<T *> bufA(n), bufB(n);
+            T **src = bufA.data(), **dst = bufB.data();
+            parallel(seg.size(), [&](size_t i) {
+                std::copy(seg[i], seg[i] + len[i], src + off[i]);
+            });
+
+            auto cmp = [this](const T *a, const T *b) {
+                return less(a, b);
+            };
+
+            size_t runs = std::min((size_t)threads, (n + blockSize - 1) / blockSize);
+            std::vector<size_t> bound;
+            for (size_t i = 0; i <= runs; ++i)
+                bound.push_back(n * i / runs);
+            parallel(runs, [&](size_t i) {
+                if (stable)
+                    std::stable_sort(src + bound[i], src + bound[i + 1], cmp);
+                else
+                    std::sort(src + bound[i], src + bound[i + 1], cmp);
+            });
+
+            while (bound.size() > 2) {
+                size_t pairs = (bound.size() - 1) / 2;
+                size_t pieces = std::max((size_t)1, threads / pairs);
+                std::vector<size_t> next;
+                for (size_t i = 0; i + 1 < bound.size(); i += 2)
+                    next.push_back(bound[i]);
+                next.push_back(n);
+
+                parallel(pairs * pieces + 1, [&](size_t t) {
+                    if (t == pairs * pieces) {
+                        // an odd run out is carried over unchanged
+                        if ((bound.size() - 1) % 2)
+                            std::copy(src + bound[bound.size() - 2], src + n, dst + bound[bound.size() - 2]);
+                        return;
+                    }
+                    size_t p = t / pieces, piece = t % pieces;
+                    T **a = src + bound[2 * p], **b = src + bound[2 * p + 1];
+                    size_t m = bound[2 * p + 1] - bound[2 * p], l = bound[2 * p + 2] - bound[2 * p + 1];
+                    size_t d0 = (m + l) * piece / pieces, d1 = (m + l) * (piece + 1) / pieces;
+                    size_t i0 = corank(d0, a, m, b, l), i1 = corank(d1, a, m, b, l);
+                    std::merge(a + i0, a + i1, b + (d0 - i0), b + (d1 - i1), dst + bound[2 * p] + d0, cmp);
+                });
+
+                bound = next;
+                std::swap(src, dst);
+            }
+
+            parallel(seg.size(), [&](size_t i) {
+                std::copy(src + off[i], src + off[i] + len[i], seg[i]);
+            });
+        }
+    };
+
+    /**
+     * sorts the elements with comp (operator< by default) using up to `threads` threads,
+     * 0 meaning one per hardware thread. equal elements may be reordered.
+     */
+    template<class T, class Compare>
+    void sort(deque<T> &q, Compare comp, unsigned threads = 0) {
+        block_sorter<T, Compare>(comp, false, threads)(q);
+    }
+
+    template<class T>
+    void sort(deque<T> &q) {
+        sort(q, std::less<T>());
+    }
+
+    /**
+     * as sort(), but equal elements keep their order.
+     */
+    template<class T, class Compare>
+    void stable_sort(deque<T> &q, Compare comp, unsigned threads = 0) {
+        block_sorter<T, Compare>(comp, true, threads)(q);
+    }
+
+    template<class T>
+    void stable_sort(deque<T> &q) {
+        stable_sort(q, std::less<T>());
+    }
+
+}
+
+#endif
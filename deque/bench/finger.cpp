@@ -0,0 +1,51 @@
+/**
+ * indexed access: a sequential q[i] loop, a strided one and a random one.
+ */
+#include <chrono>
+#include <cstdio>
+#include "../deque.hpp"
+
+const int N = 1000000;
+
+template<class F>
+void time(const char *name, F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    long long sum = f();
+    double ms = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+    printf("%-12s %9.1f ms  (checksum %lld)\n", name, ms, sum);
+}
+
+int main() {
+    sjtu::deque<int> q;
+    for (int i = 0; i < N; ++i)
+        q.push_back(i);
+
+    time("sequential", [&]() {
+        long long sum = 0;
+        for (size_t i = 0; i < q.size(); ++i)
+            sum += q[i];
+        return sum;
+    });
+    time("backward", [&]() {
+        long long sum = 0;
+        for (size_t i = q.size(); i > 0; --i)
+            sum += q[i - 1];
+        return sum;
+    });
+    time("stride 97", [&]() {
+        long long sum = 0;
+        for (size_t i = 0; i < q.size(); i += 97)
+            sum += q[i];
+        return sum;
+    });
+    time("random", [&]() {
+        long long sum = 0;
+        unsigned seed = 12345;
+        for (int i = 0; i < 20000; ++i) {
+            seed = seed * 1103515245 + 12345;
+            sum += q[(seed >> 8) % q.size()];
+        }
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * per-operation latency of random insert and erase under the eager and lazy rebalancing policies.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../deque.hpp"
+
+const int N = 300000;
+const int OPS = 200000;
+
+void run(sjtu::deque<int>::rebalance_policy policy, const char *name) {
+    sjtu::deque<int> q;
+    q.set_rebalance(policy);
+    for (int i = 0; i < N; ++i)
+        q.push_back(i);
+
+    std::vector<double> lat;
+    lat.reserve(OPS);
+    unsigned seed = 12345;
+    for (int i = 0; i < OPS; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int pos = (seed >> 8) % q.size();
+        sjtu::deque<int>::iterator it = q.begin() + pos;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        // shrink for the first half so that merges happen, grow back afterwards
+        if (i < OPS / 2 ? i % 4 != 0 : i % 4 == 0)
+            q.erase(it);
+        else
+            q.insert(it, i);
+        lat.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9);
+    }
+
+    std::sort(lat.begin(), lat.end());
+    sjtu::deque_report r = q.report();
+    printf("%-6s p50 %8.0f ns  p99 %8.0f ns  p99.9 %8.0f ns  max %9.0f ns  blocks %zu\n", name,
+           lat[lat.size() / 2], lat[lat.size() * 99 / 100], lat[lat.size() * 999 / 1000], lat.back(), r.blocks);
+}
+
+int main() {
+    run(sjtu::deque<int>::eager, "eager");
+    run(sjtu::deque<int>::lazy, "lazy");
+    return 0;
+}
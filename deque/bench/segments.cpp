@@ -0,0 +1,54 @@
+/**
+ * summing a deque through iterators, through the segmented accumulate,
+ * and the same loop over std::deque.
+ */
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include "../deque.hpp"
+#include "../algorithm.hpp"
+
+const int N = 10000000;
+
+template<class F>
+double timeit(F f, long long &result) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    result = f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+}
+
+int main() {
+    sjtu::deque<long long> q;
+    std::deque<long long> d;
+    for (long long i = 0; i < N; ++i)
+        d.push_back(i);
+    q.append(d.begin(), d.end());
+
+    long long a, b, c, e;
+    double ta = timeit([&]() {
+        long long s = 0;
+        for (sjtu::deque<long long>::iterator it = q.begin(); it != q.end(); ++it)
+            s += *it;
+        return s;
+    }, a);
+    double tb = timeit([&]() {
+        return sjtu::accumulate(q, 0LL);
+    }, b);
+    double tc = timeit([&]() {
+        long long s = 0;
+        sjtu::for_each(q, [&](long long x) { s += x; });
+        return s;
+    }, c);
+    double te = timeit([&]() {
+        long long s = 0;
+        for (std::deque<long long>::iterator it = d.begin(); it != d.end(); ++it)
+            s += *it;
+        return s;
+    }, e);
+
+    printf("%-28s %10.2f ms  (%lld)\n", "sjtu::deque iterator loop", ta, a);
+    printf("%-28s %10.2f ms  (%lld)\n", "sjtu::accumulate", tb, b);
+    printf("%-28s %10.2f ms  (%lld)\n", "sjtu::for_each", tc, c);
+    printf("%-28s %10.2f ms  (%lld)\n", "std::deque iterator loop", te, e);
+    return 0;
+}
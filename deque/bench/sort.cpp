@@ -0,0 +1,53 @@
+/**
+ * sjtu::sort against copying out to a vector, std::sort and copying back, for several thread counts.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "../deque.hpp"
+#include "../algorithm.hpp"
+
+void build(sjtu::deque<int> &q, int n) {
+    q.clear();
+    unsigned seed = 12345;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        q.push_back(seed >> 4);
+    }
+}
+
+double since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 5000000;
+    sjtu::deque<int> q;
+
+    build(q, n);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<int> v;
+    v.reserve(n);
+    sjtu::copy(q, std::back_inserter(v));
+    std::sort(v.begin(), v.end());
+    size_t k = 0;
+    sjtu::for_each(q, [&](int &x) { x = v[k++]; });
+    printf("vector + std::sort   %9.1f ms\n", since(start));
+
+    unsigned threads[] = {1, 2, 4, 8};
+    for (int t = 0; t < 4; ++t) {
+        build(q, n);
+        start = std::chrono::steady_clock::now();
+        sjtu::sort(q, std::less<int>(), threads[t]);
+        printf("sort, %u threads      %9.1f ms\n", threads[t], since(start));
+
+        build(q, n);
+        start = std::chrono::steady_clock::now();
+        sjtu::stable_sort(q, std::less<int>(), threads[t]);
+        printf("stable, %u threads    %9.1f ms\n", threads[t], since(start));
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * throughput of ws_deque against a mutex-wrapped sjtu::deque.
+ * every worker owns one deque and runs a binary fork tree of tasks:
+ * a task of depth d pushes two tasks of depth d - 1 onto its own deque.
+ * idle workers steal from a random victim.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../deque.hpp"
+#include "../ws_deque.hpp"
+
+const int DEPTH = 20;
+const long long TASKS = (1LL << (DEPTH + 1)) - 1;
+
+struct locked_deque {
+    std::mutex m;
+    sjtu::deque<int> q;
+
+    void push(int x) {
+        std::lock_guard<std::mutex> g(m);
+        q.push_back(x);
+    }
+
+    bool pop(int &x) {
+        std::lock_guard<std::mutex> g(m);
+        if (q.empty())
+            return false;
+        x = q.back();
+        q.pop_back();
+        return true;
+    }
+
+    bool steal(int &x) {
+        std::lock_guard<std::mutex> g(m);
+        if (q.empty())
+            return false;
+        x = q.front();
+        q.pop_front();
+        return true;
+    }
+};
+
+template<class Q>
+double run(int threads) {
+    std::vector<Q *> qs;
+    for (int i = 0; i < threads; ++i)
+        qs.push_back(new Q);
+    std::atomic<long long> done(0);
+
+    qs[0]->push(DEPTH);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (int id = 0; id < threads; ++id) {
+        pool.push_back(std::thread([&, id]() {
+            unsigned seed = id * 7919 + 1;
+            int x;
+            while (done.load(std::memory_order_relaxed) < TASKS) {
+                bool got = qs[id]->pop(x);
+                if (!got && threads > 1) {
+                    seed = seed * 1103515245 + 12345;
+                    int victim = (seed >> 16) % threads;
+                    if (victim != id)
+                        got = qs[victim]->steal(x);
+                }
+                if (!got)
+                    continue;
+                if (x > 0) {
+                    qs[id]->push(x - 1);
+                    qs[id]->push(x - 1);
+                }
+                done.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    }
+    for (int i = 0; i < threads; ++i)
+        pool[i].join();
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (int i = 0; i < threads; ++i)
+        delete qs[i];
+    return TASKS / sec / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    printf("%8s %16s %16s\n", "threads", "ws_deque Mops/s", "locked Mops/s");
+    for (int t = 1; t <= maxThreads; t *= 2)
+        printf("%8d %16.2f %16.2f\n", t, run<sjtu::ws_deque<int> >(t), run<locked_deque>(t));
+    return 0;
+}
@@ -0,0 +1,427 @@
+#ifndef SJTU_CIRCULAR_BUFFER_HPP
+#define SJTU_CIRCULAR_BUFFER_HPP
+
+#include "exceptions.hpp"
+#include "utility.hpp"
+
+#include <cstddef>
+#include <new>
+
+namespace sjtu {
+    /**
+     * a ring of fixed capacity, allocated once at construction.
+     * elements are stored inline, so access is O(1) and no push or pop allocates.
+     * when it is full, push_back() either overwrites the oldest element (overwrite)
+     * or refuses the new one (reject).
+     */
+    template<class T>
+    class circular_buffer {
+    public:
+        enum policy {
+            overwrite,
+            reject
+        };
+
+    private:
+        T *buf;
+        size_t cap;
+        size_t first;
+        size_t cnt;
+        policy pol;
+
+        size_t wrap(size_t i) const {
+            return i >= cap ? i - cap : i;
+        }
+
+        T *slot(size_t pos) const {
+            return buf + wrap(first + pos);
+        }
+
+        void init(size_t capacity, policy p) {
+            if (capacity == 0)
+                throw runtime_error();
+            cap = capacity;
+            first = cnt = 0;
+            pol = p;
+            buf = static_cast<T *>(::operator new(cap * sizeof(T)));
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator {
+            friend class circular_buffer;
+            friend class const_iterator;
+        private:
+            circular_buffer *cb;
+            size_t pos;
+
+        public:
+            iterator(circular_buffer *cb = NULL, size_t pos = 0) : cb(cb), pos(pos) {}
+
+            iterator operator+(const int &n) const {
+                return iterator(cb, pos + n);
+            }
+
+            iterator operator-(const int &n) const {
+                return iterator(cb, pos - n);
+            }
+
+            int operator-(const iterator &rhs) const {
+                if (cb != rhs.cb)
+                    throw invalid_iterator();
+                return (int)pos - (int)rhs.pos;
+            }
+
+            iterator &operator+=(const int &n) {
+                pos += n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n) {
+                pos -= n;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator ret = *this;
+                ++pos;
+                return ret;
+            }
+
+            iterator &operator++() {
+                ++pos;
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator ret = *this;
+                --pos;
+                return ret;
+            }
+
+            iterator &operator--() {
+                --pos;
+                return *this;
+            }
+
+            T &operator*() const {
+                if (pos >= cb->cnt)
+                    throw invalid_iterator();
+                return *cb->slot(pos);
+            }
+
+            T *operator->() const noexcept {
+                return cb->slot(pos);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return cb == rhs.cb && pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return cb == rhs.cb && pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+        };
+
+        class const_iterator {
+            friend class circular_buffer;
+            friend class iterator;
+        private:
+            const circular_buffer *cb;
+            size_t pos;
+
+        public:
+            const_iterator(const circular_buffer *cb = NULL, size_t pos = 0) : cb(cb), pos(pos) {}
+
+            const_iterator(const iterator &other) : cb(other.cb), pos(other.pos) {}
+
+            const_iterator operator+(const int &n) const {
+                return const_iterator(cb, pos + n);
+            }
+
+            const_iterator operator-(const int &n) const {
+                return const_iterator(cb, pos - n);
+            }
+
+            int operator-(const const_iterator &rhs) const {
+                if (cb != rhs.cb)
+                    throw invalid_iterator();
+                return (int)pos - (int)rhs.pos;
+            }
+
+            const_iterator &operator+=(const int &n) {
+                pos += n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n) {
+                pos -= n;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator ret = *this;
+                ++pos;
+                return ret;
+            }
+
+            const_iterator &operator++() {
+                ++pos;
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator ret = *this;
+                --pos;
+                return ret;
+            }
+
+            const_iterator &operator--() {
+                --pos;
+                return *this;
+            }
+
+            const T &operator*() const {
+                if (pos >= cb->cnt)
+                    throw invalid_iterator();
+                return *cb->slot(pos);
+            }
+
+            const T *operator->() const noexcept {
+                return cb->slot(pos);
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return cb == rhs.cb && pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return cb == rhs.cb && pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+        };
+
+        /**
+         * throw runtime_error if capacity is 0.
+         */
+        explicit circular_buffer(size_t capacity, policy p = overwrite) {
+            init(capacity, p);
+        }
+
+        circular_buffer(const circular_buffer &other) {
+            init(other.cap, other.pol);
+            try {
+                for (size_t i = 0; i < other.cnt; ++i)
+                    push_back(other[i]);
+            }
+            catch (...) {
+                clear();
+                ::operator delete(buf);
+                throw;
+            }
+        }
+
+        ~circular_buffer() {
+            clear();
+            ::operator delete(buf);
+        }
+
+        /**
+         * takes the capacity and policy of other as well.
+         */
+        circular_buffer &operator=(const circular_buffer &other) {
+            if (this == &other)
+                return *this;
+
+            clear();
+            if (cap != other.cap) {
+                ::operator delete(buf);
+                buf = NULL;
+                init(other.cap, other.pol);
+            }
+            pol = other.pol;
+            for (size_t i = 0; i < other.cnt; ++i)
+                push_back(other[i]);
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if out of bound.
+         */
+        T &at(const size_t &pos) {
+            if (pos >= cnt)
+                throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const {
+            if (pos >= cnt)
+                throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty when the container is empty.
+         */
+        const T &front() const {
+            if (empty())
+                throw container_is_empty();
+            return *slot(0);
+        }
+
+        const T &back() const {
+            if (empty())
+                throw container_is_empty();
+            return *slot(cnt - 1);
+        }
+
+        iterator begin() {
+            return iterator(this, 0);
+        }
+
+        const_iterator cbegin() const {
+            return const_iterator(this, 0);
+        }
+
+        iterator end() {
+            return iterator(this, cnt);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(this, cnt);
+        }
+
+        /**
+         * the elements as two contiguous arrays, oldest first.
+         * the second one is empty unless the contents wrap around the end of the storage.
+         */
+        pair<T *, size_t> array_one() {
+            size_t n = first + cnt > cap ? cap - first : cnt;
+            return pair<T *, size_t>(buf + first, n);
+        }
+
+        pair<T *, size_t> array_two() {
+            size_t n = first + cnt > cap ? first + cnt - cap : 0;
+            return pair<T *, size_t>(buf, n);
+        }
+
+        pair<const T *, size_t> array_one() const {
+            size_t n = first + cnt > cap ? cap - first : cnt;
+            return pair<const T *, size_t>(buf + first, n);
+        }
+
+        pair<const T *, size_t> array_two() const {
+            size_t n = first + cnt > cap ? first + cnt - cap : 0;
+            return pair<const T *, size_t>(buf, n);
+        }
+
+        bool empty() const {
+            return cnt == 0;
+        }
+
+        bool full() const {
+            return cnt == cap;
+        }
+
+        size_t size() const {
+            return cnt;
+        }
+
+        size_t capacity() const {
+            return cap;
+        }
+
+        void clear() {
+            for (size_t i = 0; i < cnt; ++i)
+                slot(i)->~T();
+            first = cnt = 0;
+        }
+
+        /**
+         * adds an element to the end.
+         * when full, the oldest element is overwritten (overwrite) or value is dropped (reject).
+         * overwriting assigns value to the oldest slot and only then makes it the newest,
+         * so value may be an element of this buffer, and a throwing copy evicts nothing.
+         * returns false if value was dropped.
+         */
+        bool push_back(const T &value) {
+            if (cnt == cap) {
+                if (pol == reject)
+                    return false;
+                *slot(0) = value;
+                first = wrap(first + 1);
+                return true;
+            }
+            new (slot(cnt)) T(value);
+            cnt++;
+            return true;
+        }
+
+        /**
+         * adds an element to the beginning.
+         * when full, the newest element is overwritten (overwrite) or value is dropped (reject),
+         * the same way as push_back().
+         * returns false if value was dropped.
+         */
+        bool push_front(const T &value) {
+            if (cnt == cap) {
+                if (pol == reject)
+                    return false;
+                // the newest slot is the one just before first
+                *slot(cnt - 1) = value;
+                first = wrap(first + cap - 1);
+                return true;
+            }
+            new (buf + wrap(first + cap - 1)) T(value);
+            first = wrap(first + cap - 1);
+            cnt++;
+            return true;
+        }
+
+        /**
+         * throw container_is_empty when the container is empty.
+         */
+        void pop_back() {
+            if (empty())
+                throw container_is_empty();
+            slot(cnt - 1)->~T();
+            cnt--;
+        }
+
+        void pop_front() {
+            if (empty())
+                throw container_is_empty();
+            slot(0)->~T();
+            first = wrap(first + 1);
+            cnt--;
+        }
+    };
+
+}
+
+#endif
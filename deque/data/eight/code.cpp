@@ -0,0 +1,121 @@
+#include "class-integer.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <list>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool same(sjtu::deque<T> &q, const std::deque<T> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	typename sjtu::deque<T>::iterator it = q.begin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (!(*it == d[i]) || !(q[i] == d[i]))
+			return false;
+	}
+	return it == q.end();
+}
+
+void TestAppendAndPrepend()
+{
+	std::cout << "Test 1 : Test for append and prepend...";
+	sjtu::deque<Integer> q;
+	std::deque<Integer> d;
+	std::vector<Integer> v;
+	for (int i = 0; i < N; ++i)
+		v.push_back(Integer(randNum(i, N + 17)));
+	q.append(v.begin(), v.end());
+	d.insert(d.end(), v.begin(), v.end());
+	q.prepend(v.begin(), v.begin() + 1234);
+	d.insert(d.begin(), v.begin(), v.begin() + 1234);
+	q.append(v.begin(), v.begin());
+	q.prepend(v.begin(), v.begin());
+	if (!same(q, d))
+		error();
+	sjtu::deque<Integer> e;
+	e.prepend(v.begin(), v.begin() + 7);
+	e.append(v.begin() + 7, v.begin() + 10);
+	for (int i = 0; i < 10; ++i) {
+		if (!(e[i] == v[i]))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestRangeInsert()
+{
+	std::cout << "Test 2 : Test for range insert at random positions...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	std::list<long long> l;
+	for (long long i = 0; i < 777; ++i)
+		l.push_back(i * 3);
+	for (long long i = 0; i < 300; ++i) {
+		int pos = randNum(i, d.size() + 1) - 1;
+		std::list<long long>::iterator b = l.begin(), e = l.end();
+		for (int k = 0; k < i % 5; ++k)
+			++b;
+		for (int k = 0; k < i % 7 * 100; ++k)
+			--e;
+		sjtu::deque<long long>::iterator it = q.insert(q.begin() + pos, b, e);
+		d.insert(d.begin() + pos, b, e);
+		if (b != e && (it - q.begin() != pos || *it != *b))
+			error();
+		q.push_back(i);
+		d.push_back(i);
+		pos = randNum(i + 3, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+	}
+	if (!same(q, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestAssign()
+{
+	std::cout << "Test 3 : Test for assign...";
+	sjtu::deque<long long> q;
+	for (long long i = 0; i < 1000; ++i)
+		q.push_back(i);
+	q.assign(N, 233);
+	if (q.size() != N)
+		error();
+	for (size_t i = 0; i < N; ++i) {
+		if (q[i] != 233)
+			error();
+	}
+	q.assign(0, 1);
+	if (!q.empty() || q.begin() != q.end())
+		error();
+	q.push_front(1);
+	q.push_back(2);
+	if (q.front() != 1 || q.back() != 2)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestAppendAndPrepend();
+	TestRangeInsert();
+	TestAssign();
+	std::cout << "Congratulations. Your bulk operations have passed all correctness tests." << std::endl;
+	return 0;
+}
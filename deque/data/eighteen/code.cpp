@@ -0,0 +1,148 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "../deque.hpp"
+#include "../algorithm.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct Item {
+	int key, seq;
+	Item(int key, int seq) : key(key), seq(seq) {}
+};
+
+bool byKey(const Item &a, const Item &b)
+{
+	return a.key < b.key;
+}
+
+template<class T>
+bool same(sjtu::deque<T> &q, const std::vector<T> &v)
+{
+	if (q.size() != v.size())
+		return false;
+	typename sjtu::deque<T>::iterator it = q.begin();
+	for (size_t i = 0; i < v.size(); ++i, ++it) {
+		if (!(*it == v[i]))
+			return false;
+	}
+	return true;
+}
+
+void TestSort()
+{
+	std::cout << "Test 1 : Test for sort with any number of threads...";
+	unsigned threads[] = {1, 2, 3, 4, 7, 0};
+	for (int t = 0; t < 6; ++t) {
+		sjtu::deque<long long> q;
+		std::vector<long long> v;
+		for (size_t i = 0; i < N; ++i) {
+			long long x = randNum(i * (t + 3), 1000);
+			if (i % 2) {
+				q.push_back(x);
+				v.push_back(x);
+			}
+			else {
+				q.push_front(x);
+				v.insert(v.begin(), x);
+			}
+		}
+		sjtu::sort(q, std::less<long long>(), threads[t]);
+		std::sort(v.begin(), v.end());
+		if (!same(q, v))
+			error();
+		sjtu::sort(q, std::greater<long long>(), threads[t]);
+		std::sort(v.begin(), v.end(), std::greater<long long>());
+		if (!same(q, v))
+			error();
+	}
+	for (size_t n = 0; n < 5; ++n) {
+		sjtu::deque<long long> q;
+		std::vector<long long> v;
+		for (size_t i = 0; i < n; ++i) {
+			q.push_back(n - i);
+			v.push_back(n - i);
+		}
+		sjtu::sort(q);
+		std::sort(v.begin(), v.end());
+		if (!same(q, v))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestStable()
+{
+	std::cout << "Test 2 : Test for stable_sort keeping equal elements in order...";
+	for (unsigned t = 1; t <= 5; t += 2) {
+		sjtu::deque<Item> q;
+		for (size_t i = 0; i < N; ++i)
+			q.push_back(Item(randNum(i, 50), i));
+		sjtu::stable_sort(q, byKey, t);
+		if (q.size() != N)
+			error();
+		for (size_t i = 1; i < N; ++i) {
+			const Item &a = q[i - 1], &b = q[i];
+			if (a.key > b.key || (a.key == b.key && a.seq >= b.seq))
+				error();
+		}
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestInPlace()
+{
+	std::cout << "Test 3 : Test for sorting in place, shared blocks and throwing comparators...";
+	sjtu::deque<long long> q, snap;
+	std::vector<long long> v;
+	for (size_t i = 0; i < N; ++i) {
+		q.push_back(N - i);
+		v.push_back(N - i);
+	}
+	const long long *smallest = &q[N - 1];
+	sjtu::sort(q, std::less<long long>(), 4);
+	std::sort(v.begin(), v.end());
+	if (&q[0] != smallest || !same(q, v))
+		error();
+
+	snap.share(q);
+	sjtu::sort(snap, std::greater<long long>(), 3);
+	if (!same(q, v) || snap[0] != (long long)N || snap[N - 1] != 1)
+		error();
+
+	std::reverse(v.begin(), v.end());
+	int calls = 0;
+	try {
+		sjtu::sort(snap, [&](long long a, long long b) {
+			if (++calls == 5000)
+				throw sjtu::runtime_error();
+			return a < b;
+		}, 1);
+		error();
+	} catch (sjtu::runtime_error) {}
+	if (!same(snap, v))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSort();
+	TestStable();
+	TestInPlace();
+	std::cout << "Congratulations. Your deque sorts correctly." << std::endl;
+	return 0;
+}
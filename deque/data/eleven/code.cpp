@@ -0,0 +1,123 @@
+#include "class-integer.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <numeric>
+#include <algorithm>
+#include <cstdlib>
+#include "../deque.hpp"
+#include "../algorithm.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct Summer {
+	long long sum;
+	Summer() : sum(0) {}
+	void operator()(const long long &x) { sum += x; }
+};
+
+void build(sjtu::deque<long long> &q, std::deque<long long> &d)
+{
+	for (long long i = 0; i < N; ++i) {
+		long long x = randNum(i, 1000007);
+		if (i % 3) {
+			q.push_back(x);
+			d.push_back(x);
+		}
+		else {
+			q.push_front(x);
+			d.push_front(x);
+		}
+	}
+	for (long long i = 0; i < 20000; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+	}
+}
+
+void TestSegments()
+{
+	std::cout << "Test 1 : Test for walking the deque block by block...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	build(q, d);
+	size_t k = 0;
+	for (sjtu::deque<long long>::const_segment_iterator s = q.csegment_begin(); s != q.csegment_end(); ++s) {
+		if (s.end() - s.begin() != s.size())
+			error();
+		for (const long long *const *p = s.begin(); p != s.end(); ++p, ++k) {
+			if (**p != d[k])
+				error();
+		}
+	}
+	if (k != d.size())
+		error();
+	sjtu::deque<long long> e;
+	sjtu::deque<long long>::segment_iterator s = e.segment_begin();
+	if (s.size() != 0 || ++s != e.segment_end())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestAlgorithms()
+{
+	std::cout << "Test 2 : Test for for_each, copy, find, accumulate and fill...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	build(q, d);
+	const sjtu::deque<long long> &cq = q;
+
+	if (sjtu::for_each(q, Summer()).sum != std::accumulate(d.begin(), d.end(), 0LL))
+		error();
+	if (sjtu::for_each(cq, Summer()).sum != std::accumulate(d.begin(), d.end(), 0LL))
+		error();
+	if (sjtu::accumulate(cq, 0LL) != std::accumulate(d.begin(), d.end(), 0LL))
+		error();
+	if (sjtu::accumulate(cq, 0LL, [](long long a, long long b) { return std::max(a, b); }) !=
+		*std::max_element(d.begin(), d.end()))
+		error();
+
+	std::vector<long long> v(d.size() + 3);
+	if (sjtu::copy(cq, v.begin()) != v.begin() + d.size() || !std::equal(d.begin(), d.end(), v.begin()))
+		error();
+
+	for (int i = 0; i < 200; ++i) {
+		long long x = randNum(i * 31, 1000007);
+		std::deque<long long>::iterator a = std::find(d.begin(), d.end(), x);
+		sjtu::deque<long long>::iterator b = sjtu::find(q, x);
+		sjtu::deque<long long>::const_iterator c = sjtu::find(cq, x);
+		if ((a == d.end()) != (b == q.end()) || (a == d.end()) != (c == cq.cend()))
+			error();
+		if (a != d.end() && (b - q.begin() != a - d.begin() || c - cq.cbegin() != a - d.begin() || *b != x))
+			error();
+	}
+
+	sjtu::deque<long long> snap;
+	snap.share(q);
+	sjtu::fill(q, 7LL);
+	for (size_t i = 0; i < q.size(); ++i) {
+		if (q[i] != 7 || snap[i] != d[i])
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSegments();
+	TestAlgorithms();
+	std::cout << "Congratulations. Your segmented algorithms have passed all correctness tests." << std::endl;
+	return 0;
+}
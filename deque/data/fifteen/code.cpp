@@ -0,0 +1,181 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "../spill_queue.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 200005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct Record {
+	long long key;
+	int tag;
+	char pad[20];
+};
+
+void TestFifo()
+{
+	std::cout << "Test 1 : Test for FIFO order across the spill file...";
+	sjtu::spill_queue<long long> q(64, 2, 3);
+	std::queue<long long> d;
+	size_t maxSpilled = 0;
+	for (long long i = 0; i < (long long)N; ++i) {
+		long long x = randNum(i, N);
+		q.push(x);
+		d.push(x);
+		if (i % 3 == 0) {
+			if (q.front() != d.front())
+				error();
+			q.pop();
+			d.pop();
+		}
+		if (q.size() != d.size() || (!d.empty() && q.back() != d.back()))
+			error();
+		if (q.spilled() > maxSpilled)
+			maxSpilled = q.spilled();
+	}
+	if (maxSpilled == 0)
+		error();
+	while (!d.empty()) {
+		if (q.front() != d.front())
+			error();
+		q.pop();
+		d.pop();
+	}
+	if (!q.empty() || q.spilled() != 0)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestBursts()
+{
+	std::cout << "Test 2 : Test for bursts of pushes and pops...";
+	sjtu::spill_queue<Record> q(10, 1, 1);
+	std::queue<Record> d;
+	long long k = 0;
+	for (int round = 0; round < 300; ++round) {
+		int pushes = (int)randNum(round, 97), pops = (int)randNum(round + 5, 97);
+		for (int i = 0; i < pushes; ++i, ++k) {
+			Record r;
+			r.key = k;
+			r.tag = round;
+			q.push(r);
+			d.push(r);
+		}
+		for (int i = 0; i < pops && !d.empty(); ++i) {
+			if (q.front().key != d.front().key || q.front().tag != d.front().tag)
+				error();
+			q.pop();
+			d.pop();
+		}
+		if (q.size() != d.size())
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestBounds()
+{
+	std::cout << "Test 3 : Test for exceptions...";
+	int caught = 0;
+	sjtu::spill_queue<int> q(4);
+	try { q.front(); } catch (sjtu::container_is_empty) { caught++; }
+	try { q.pop(); } catch (sjtu::container_is_empty) { caught++; }
+	try { sjtu::spill_queue<int> z(0); } catch (sjtu::runtime_error) { caught++; }
+	q.push(1);
+	q.pop();
+	try { q.back(); } catch (sjtu::container_is_empty) { caught++; }
+	if (caught != 4)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestFullDisk()
+{
+	std::cout << "Test 4 : Test for a spill file which cannot be written...";
+	sjtu::spill_queue<long long> q(8, 2, 2, "/dev/full");
+	std::vector<long long> accepted;
+	int failed = 0;
+	for (long long i = 0; i < 1000; ++i) {
+		try {
+			q.push(i);
+			accepted.push_back(i);
+		}
+		catch (sjtu::runtime_error &) {
+			failed++;
+		}
+		if (i % 7 == 0 && !q.empty()) {
+			if (q.front() != accepted[accepted.size() - q.size()])
+				error();
+			q.pop();
+		}
+	}
+	if (failed == 0 || q.spilled() != 0)
+		error();
+	size_t k = accepted.size() - q.size();
+	for (; k < accepted.size(); ++k) {
+		if (q.empty() || q.front() != accepted[k])
+			error();
+		q.pop();
+	}
+	if (!q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestLostFile()
+{
+	std::cout << "Test 5 : Test for a spill file which cannot be read back...";
+	const char *path = "spill_queue_test.tmp";
+	{
+		sjtu::spill_queue<int> q(8, 1, 1, path);
+		for (int i = 0; i < 200; ++i)
+			q.push(i);
+		if (q.spilled() == 0)
+			error();
+		std::FILE *f = std::fopen(path, "wb");
+		if (f == NULL)
+			error();
+		std::fclose(f);
+
+		int caught = 0;
+		for (int i = 0; i < 200 && caught < 3; ++i) {
+			size_t size = q.size();
+			int front = q.front();
+			try {
+				q.pop();
+			}
+			catch (sjtu::runtime_error &) {
+				caught++;
+				if (q.size() != size || q.front() != front || q.front() != 200 - (int)size)
+					error();
+			}
+		}
+		if (caught != 3)
+			error();
+	}
+	std::remove(path);
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestFifo();
+	TestBursts();
+	TestBounds();
+	TestFullDisk();
+	TestLostFile();
+	std::cout << "Congratulations. Your spill queue has passed all correctness tests." << std::endl;
+	return 0;
+}
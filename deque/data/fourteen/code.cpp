@@ -0,0 +1,144 @@
+#include "class-integer.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 50005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+bool same(sjtu::deque<long long> &q, const std::deque<long long> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	sjtu::deque<long long>::iterator it = q.begin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (*it != d[i] || q[i] != d[i])
+			return false;
+	}
+	return it == q.end();
+}
+
+void TestLazyInsertAndErase()
+{
+	std::cout << "Test 1 : Test for random insert and erase with lazy rebalancing...";
+	sjtu::deque<long long> q;
+	q.set_rebalance(sjtu::deque<long long>::lazy);
+	std::deque<long long> d;
+	for (long long i = 0; i < N; ++i) {
+		q.push_back(i);
+		d.push_back(i);
+	}
+	for (long long i = 0; i < N; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+		if (i % 3 == 0) {
+			pos = randNum(i + 5, d.size() + 1) - 1;
+			q.insert(q.begin() + pos, -i);
+			d.insert(d.begin() + pos, -i);
+		}
+	}
+	if (!same(q, d))
+		error();
+	while (!d.empty()) {
+		if (d.size() % 2) {
+			q.pop_front();
+			d.pop_front();
+		}
+		else {
+			q.pop_back();
+			d.pop_back();
+		}
+	}
+	if (!same(q, d) || !q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestLazyBand()
+{
+	std::cout << "Test 2 : Test for lazy blocks staying above a quarter and compact...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	q.set_rebalance(sjtu::deque<long long>::lazy);
+	for (long long i = 0; i < N; ++i) {
+		q.push_back(i);
+		d.push_back(i);
+	}
+	for (long long i = 0; i < N / 2; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+	}
+	sjtu::deque_report r = q.report();
+	size_t low = r.histogram[0] + r.histogram[1];
+	if (low > 2)
+		error();
+	q.compact();
+	r = q.report();
+	if (!same(q, d) || r.histogram[9] != r.blocks - 1)
+		error();
+
+	sjtu::deque<long long> c(q);
+	if (c.get_rebalance() != sjtu::deque<long long>::lazy || !same(c, d))
+		error();
+	sjtu::deque<long long> a, e;
+	a = q;
+	if (a.get_rebalance() != sjtu::deque<long long>::lazy || !same(a, d))
+		error();
+	a = e;
+	if (a.get_rebalance() != sjtu::deque<long long>::eager || !a.empty())
+		error();
+	a.share(q);
+	if (a.get_rebalance() != sjtu::deque<long long>::lazy || !same(a, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestRangeInsertPolicy()
+{
+	std::cout << "Test 3 : Test for range insert rebalancing by the policy...";
+	std::vector<long long> v;
+	for (long long i = 0; i < 5; ++i)
+		v.push_back(-i);
+	for (int k = 0; k < 2; ++k) {
+		sjtu::deque<long long> q;
+		std::deque<long long> d;
+		if (k == 0)
+			q.set_rebalance(sjtu::deque<long long>::lazy);
+		for (long long i = 0; i < N; ++i) {
+			q.push_back(i);
+			d.push_back(i);
+		}
+		q.compact(1.0 / 3);
+		size_t before = q.report().blocks;
+		int pos = sjtu::blockSize / 3 + sjtu::blockSize / 6;
+		q.insert(q.begin() + pos, v.begin(), v.end());
+		d.insert(d.begin() + pos, v.begin(), v.end());
+		size_t after = q.report().blocks;
+		if (!same(q, d) || (k == 0 ? after != before : after >= before))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestLazyInsertAndErase();
+	TestLazyBand();
+	TestRangeInsertPolicy();
+	std::cout << "Congratulations. Your lazy deque has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include "../ws_deque.hpp"
+
+const int N = 2000000;
+const int THIEVES = 7;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestSingleThread()
+{
+	std::cout << "Test 1 : Test for push, pop and steal in one thread...";
+	sjtu::ws_deque<int> q(2);
+	int x;
+	if (q.pop(x) || q.steal(x) || !q.empty())
+		error();
+	for (int i = 0; i < 1000; ++i)
+		q.push(i);
+	if (q.size() != 1000)
+		error();
+	for (int i = 0; i < 500; ++i) {
+		if (!q.steal(x) || x != i)
+			error();
+		if (!q.pop(x) || x != 999 - i)
+			error();
+	}
+	if (q.pop(x) || q.steal(x) || !q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestStress()
+{
+	std::cout << "Test 2 : Test for every element taken exactly once under concurrent stealing...";
+	sjtu::ws_deque<int> q;
+	std::vector<std::atomic<int>> seen(N);
+	for (int i = 0; i < N; ++i)
+		seen[i].store(0);
+	std::atomic<bool> done(false);
+	std::atomic<long long> taken(0);
+
+	std::vector<std::thread> thieves;
+	for (int k = 0; k < THIEVES; ++k) {
+		thieves.push_back(std::thread([&]() {
+			int x;
+			while (!done.load()) {
+				if (q.steal(x)) {
+					seen[x].fetch_add(1);
+					taken.fetch_add(1);
+				}
+			}
+		}));
+	}
+
+	int x;
+	for (int i = 0; i < N; ++i) {
+		q.push(i);
+		if (i % 3 == 0 && q.pop(x)) {
+			seen[x].fetch_add(1);
+			taken.fetch_add(1);
+		}
+	}
+	while (q.pop(x)) {
+		seen[x].fetch_add(1);
+		taken.fetch_add(1);
+	}
+	while (taken.load() < N && !q.empty())
+		std::this_thread::yield();
+	done.store(true);
+	for (int k = 0; k < THIEVES; ++k)
+		thieves[k].join();
+
+	if (taken.load() != N)
+		error();
+	for (int i = 0; i < N; ++i) {
+		if (seen[i].load() != 1)
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSingleThread();
+	TestStress();
+	std::cout << "Congratulations. Your work-stealing deque has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "class-integer.hpp"
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool same(sjtu::deque<T> &q, std::deque<T> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	for (size_t i = 0; i < d.size(); ++i) {
+		if (!(d[i] == q[i]))
+			return false;
+	}
+	return true;
+}
+
+void TestEmpty()
+{
+	std::cout << "Test 1 : Test for the footprint of empty and tiny deques...";
+	sjtu::deque<long long> q;
+	sjtu::deque_report r = q.report();
+	if (r.blocks != 1 || r.allocated > 256)
+		error();
+	q.push_back(1);
+	q.push_front(0);
+	r = q.report();
+	if (r.blocks != 1 || r.allocated > 384 || q.front() != 0 || q.back() != 1)
+		error();
+	q.pop_back();
+	q.pop_back();
+	q.clear();
+	if (!q.empty() || q.report().allocated > 256)
+		error();
+
+	std::vector<sjtu::deque<Integer> > many(1000);
+	for (size_t i = 0; i < many.size(); ++i) {
+		for (size_t j = 0; j < i % 5; ++j)
+			many[i].push_back(Integer(j));
+	}
+	for (size_t i = 0; i < many.size(); ++i) {
+		if (many[i].size() != i % 5)
+			error();
+		if (i % 5) {
+			Integer b = many[i].back();
+			if (!(b == Integer(i % 5 - 1)))
+				error();
+		}
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestGrowth()
+{
+	std::cout << "Test 2 : Test for blocks growing up to the full size...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	size_t lastAllocated = q.report().allocated;
+	for (size_t i = 0; i < 2000; ++i) {
+		long long x = randNum(i, N);
+		if (i % 3) {
+			q.push_back(x);
+			d.push_back(x);
+		}
+		else {
+			q.push_front(x);
+			d.push_front(x);
+		}
+		sjtu::deque_report r = q.report();
+		if (r.allocated < lastAllocated && r.blocks == 1)
+			error();
+		lastAllocated = r.allocated;
+		if (i < sjtu::blockSize && r.blocks != 1)
+			error();
+	}
+	if (!same(q, d))
+		error();
+
+	sjtu::deque<long long> big;
+	std::vector<long long> v(N, 7);
+	big.append(v.begin(), v.end());
+	sjtu::deque_report r = big.report();
+	if (r.blocks != (N + sjtu::blockSize - 1) / sjtu::blockSize || r.histogram[9] != r.blocks - 1)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestMixed()
+{
+	std::cout << "Test 3 : Test for random operations on small blocks...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	for (int round = 0; round < 40000; ++round) {
+		long long x = randNum(round, N);
+		size_t k = d.empty() ? 0 : randNum(round * 7, d.size()) - 1;
+		switch (round % 7) {
+			case 0: case 1:
+				q.insert(q.begin() + k, x);
+				d.insert(d.begin() + k, x);
+				break;
+			case 2:
+				q.push_back(x);
+				d.push_back(x);
+				break;
+			case 3:
+				if (!d.empty()) {
+					q.erase(q.begin() + k);
+					d.erase(d.begin() + k);
+				}
+				break;
+			case 4:
+				if (!d.empty()) {
+					q.pop_front();
+					d.pop_front();
+				}
+				break;
+			case 5: {
+				sjtu::deque<long long> r = q.split_at(q.begin() + k);
+				sjtu::deque<long long> c(r), s;
+				s.share(r);
+				s.push_front(-1);
+				q.splice_back(std::move(c));
+				break;
+			}
+			case 6:
+				if (round % 700 == 6)
+					q.compact(0.3);
+				if (round % 5000 == 6) {
+					q.clear();
+					d.clear();
+				}
+				break;
+		}
+		if (q.size() != d.size() || (!d.empty() && (q.front() != d.front() || q.back() != d.back())))
+			error();
+	}
+	if (!same(q, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestEmpty();
+	TestGrowth();
+	TestMixed();
+	std::cout << "Congratulations. Your deque sizes its blocks correctly." << std::endl;
+	return 0;
+}
@@ -0,0 +1,152 @@
+#include "class-integer.hpp"
+#include "class-matrix.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../rope.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 50005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool same(const sjtu::rope<T> &r, const std::deque<T> &d)
+{
+	if (r.size() != d.size())
+		return false;
+	typename sjtu::rope<T>::const_iterator it = r.cbegin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (!(*it == d[i]) || !(r[i] == d[i]))
+			return false;
+	}
+	return it == r.cend();
+}
+
+void TestInteger()
+{
+	std::cout << "Test 1 : Test for classes without default constructor...";
+	sjtu::rope<Integer> rInt;
+	std::vector<Integer> vInt;
+	for (int i = 0; i < N; ++i) {
+		vInt.push_back(Integer(randNum(i, N + 17)));
+		rInt.push_back(vInt[i]);
+	}
+	for (int i = 0; i < N; ++i) {
+		if (!(vInt[i] == rInt[i]))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestMiddleInsertAndErase()
+{
+	std::cout << "Test 2 : Test for insert and erase at random positions...";
+	sjtu::rope<long long> r;
+	std::deque<long long> d;
+	for (long long i = 0; i < N; ++i) {
+		size_t pos = randNum(i, d.size() + 1) - 1;
+		r.insert(pos, i);
+		d.insert(d.begin() + pos, i);
+	}
+	if (!same(r, d))
+		error();
+	for (long long i = 0; i < N - 100; ++i) {
+		size_t pos = randNum(i * 7 + 3, d.size()) - 1;
+		r.erase(pos);
+		d.erase(d.begin() + pos);
+	}
+	if (!same(r, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestIterator()
+{
+	std::cout << "Test 3 : Test for iterator insert, erase and arithmetic...";
+	sjtu::rope<long long> r;
+	std::deque<long long> d;
+	for (long long i = 0; i < 20000; ++i) {
+		r.push_back(i);
+		d.push_back(i);
+	}
+	for (long long i = 0; i < 5000; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		sjtu::rope<long long>::iterator it = r.insert(r.begin() + pos, -i);
+		d.insert(d.begin() + pos, -i);
+		if (*it != -i || it - r.begin() != pos)
+			error();
+		pos = randNum(i + 11, d.size()) - 1;
+		it = r.erase(r.begin() + pos);
+		d.erase(d.begin() + pos);
+		if (pos < (int)d.size() && *it != d[pos])
+			error();
+	}
+	if (!same(r, d))
+		error();
+	sjtu::rope<long long>::iterator it = r.end();
+	for (int i = d.size() - 1; i >= 0; --i) {
+		--it;
+		if (*it != d[i])
+			error();
+	}
+	if (it != r.begin())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCopyAndPopPush()
+{
+	std::cout << "Test 4 : Test for copy, assignment, push and pop...";
+	sjtu::rope<Diamond::Matrix<double>> *p = new sjtu::rope<Diamond::Matrix<double>>;
+	std::deque<Diamond::Matrix<double>> d;
+	for (int i = 0; i < 3000; ++i) {
+		Diamond::Matrix<double> m(randNum(i + 1, 7), randNum(i + 2, 7), i * 1.0);
+		if (i % 2) {
+			p->push_back(m);
+			d.push_back(m);
+		}
+		else {
+			p->push_front(m);
+			d.push_front(m);
+		}
+	}
+	sjtu::rope<Diamond::Matrix<double>> c(*p), e;
+	e = c;
+	e = e;
+	delete p;
+	std::deque<Diamond::Matrix<double>> f(d);
+	for (int i = 0; i < 1000; ++i) {
+		c.pop_back();
+		d.pop_back();
+		e.pop_front();
+		f.pop_front();
+	}
+	for (size_t i = 0; i < d.size(); ++i) {
+		if (!(c[i] == d[i]) || !(e[i] == f[i]))
+			error();
+	}
+	c.clear();
+	if (!c.empty() || c.begin() != c.end())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestInteger();
+	TestMiddleInsertAndErase();
+	TestIterator();
+	TestCopyAndPopPush();
+	std::cout << "Congratulations. Your rope has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+bool sameByIndex(sjtu::deque<long long> &q, const std::deque<long long> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	for (size_t i = 0; i < d.size(); ++i) {
+		if (q[i] != d[i])
+			return false;
+	}
+	for (size_t i = d.size(); i > 0; --i) {
+		if (q.at(i - 1) != d[i - 1])
+			return false;
+	}
+	return true;
+}
+
+void TestWalks()
+{
+	std::cout << "Test 1 : Test for sequential, backward and strided indexing...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	for (size_t i = 0; i < N; ++i) {
+		long long x = randNum(i, N);
+		if (i % 2) {
+			q.push_back(x);
+			d.push_back(x);
+		}
+		else {
+			q.push_front(x);
+			d.push_front(x);
+		}
+	}
+	if (!sameByIndex(q, d))
+		error();
+	for (size_t s = 1; s < 2000; s = s * 3 + 1) {
+		for (size_t i = 0; i < d.size(); i += s) {
+			if (q[i] != d[i] || q[d.size() - 1 - i] != d[d.size() - 1 - i])
+				error();
+		}
+	}
+	const sjtu::deque<long long> &c = q;
+	for (size_t i = 0; i < d.size(); i += 7) {
+		if (c.at(i) != d[i])
+			error();
+	}
+	int caught = 0;
+	try { q.at(N); } catch (sjtu::index_out_of_bound) { caught++; }
+	try { c.at(N + 5); } catch (sjtu::index_out_of_bound) { caught++; }
+	if (caught != 2)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestMutations()
+{
+	std::cout << "Test 2 : Test for indexing between structural changes...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	for (size_t i = 0; i < N / 4; ++i) {
+		q.push_back(i);
+		d.push_back(i);
+	}
+	for (int round = 0; round < 3000; ++round) {
+		size_t k = randNum(round, d.size()) - 1;
+		if (q[k] != d[k] || q[k / 2] != d[k / 2])
+			error();
+		switch (round % 6) {
+			case 0:
+				q.insert(q.begin() + k, -round);
+				d.insert(d.begin() + k, -round);
+				break;
+			case 1:
+				q.erase(q.begin() + k);
+				d.erase(d.begin() + k);
+				break;
+			case 2:
+				q.pop_front();
+				d.pop_front();
+				q.push_back(round);
+				d.push_back(round);
+				break;
+			case 3: {
+				std::vector<long long> v(randNum(round, 700), round);
+				q.insert(q.begin() + k, v.begin(), v.end());
+				d.insert(d.begin() + k, v.begin(), v.end());
+				break;
+			}
+			case 4: {
+				sjtu::deque<long long> r = q.split_at(q.begin() + k);
+				if (r.size() && r[r.size() - 1] != d.back())
+					error();
+				q.splice_back(std::move(r));
+				break;
+			}
+			case 5:
+				if (round % 60 == 5)
+					q.compact(0.5);
+				q[k] = round;
+				d[k] = round;
+				break;
+		}
+		if (q[d.size() - 1] != d.back() || q[0] != d.front())
+			error();
+	}
+	if (!sameByIndex(q, d))
+		error();
+	q.clear();
+	d.clear();
+	q.push_back(3);
+	if (q[0] != 3 || q.size() != 1)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestWalks();
+	TestMutations();
+	std::cout << "Congratulations. Your deque indexes correctly." << std::endl;
+	return 0;
+}
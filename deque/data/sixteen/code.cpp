@@ -0,0 +1,152 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+bool same(sjtu::deque<long long> &q, const std::deque<long long> &d)
+{
+	if (q.size() != d.size() || q.empty() != d.empty())
+		return false;
+	sjtu::deque<long long>::iterator it = q.begin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (*it != d[i] || q[i] != d[i])
+			return false;
+	}
+	if (!d.empty() && (q.front() != d.front() || q.back() != d.back()))
+		return false;
+	return it == q.end();
+}
+
+void fill(sjtu::deque<long long> &q, std::deque<long long> &d, long long from, size_t n)
+{
+	for (size_t i = 0; i < n; ++i) {
+		long long x = randNum(from + i, N);
+		if (i % 3 == 0) {
+			q.push_front(x);
+			d.push_front(x);
+		}
+		else {
+			q.push_back(x);
+			d.push_back(x);
+		}
+	}
+}
+
+void TestSplice()
+{
+	std::cout << "Test 1 : Test for splice_back and splice_front...";
+	sjtu::deque<long long> q, a, b;
+	std::deque<long long> d, da, db;
+	fill(q, d, 0, N);
+	fill(a, da, 7, N / 3);
+	fill(b, db, 11, 1234);
+
+	long long *first = &a[0], *last = &b[b.size() - 1];
+	q.splice_back(std::move(a));
+	d.insert(d.end(), da.begin(), da.end());
+	q.splice_front(std::move(b));
+	d.insert(d.begin(), db.begin(), db.end());
+	if (!a.empty() || !b.empty() || !same(q, d))
+		error();
+	if (&q[N + 1234] != first || &q[1233] != last)
+		error();
+
+	a.push_back(-1);
+	q.splice_back(std::move(a));
+	d.push_back(-1);
+	q.splice_front(std::move(a));
+	q.splice_back(std::move(q));
+	if (!same(q, d))
+		error();
+
+	sjtu::deque<long long> e;
+	e.splice_front(std::move(q));
+	if (!q.empty() || !same(e, d))
+		error();
+	e.splice_back(std::move(q));
+	q.push_back(5);
+	if (!same(e, d) || q.size() != 1)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSplit()
+{
+	std::cout << "Test 2 : Test for split_at...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	fill(q, d, 3, N);
+
+	for (int round = 0; round < 50; ++round) {
+		size_t k = randNum(round * 131, d.size() + 1) - 1;
+		sjtu::deque<long long> r = q.split_at(q.begin() + k);
+		std::deque<long long> dr(d.begin() + k, d.end());
+		d.erase(d.begin() + k, d.end());
+		if (!same(q, d) || !same(r, dr))
+			error();
+
+		r.push_front(round);
+		dr.push_front(round);
+		q.push_back(-round);
+		d.push_back(-round);
+		q.splice_back(std::move(r));
+		d.insert(d.end(), dr.begin(), dr.end());
+		if (!same(q, d))
+			error();
+	}
+
+	sjtu::deque<long long> all = q.split_at(q.begin());
+	sjtu::deque<long long> none = all.split_at(all.end());
+	if (!q.empty() || !none.empty() || !same(all, d))
+		error();
+	q.push_back(1);
+	if (q.size() != 1 || q.front() != 1)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestLazy()
+{
+	std::cout << "Test 3 : Test for splitting and splicing under lazy rebalancing...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	q.set_rebalance(sjtu::deque<long long>::lazy);
+	fill(q, d, 5, N / 2);
+	for (int round = 0; round < 200; ++round) {
+		size_t k = randNum(round * 17, d.size() + 1) - 1;
+		sjtu::deque<long long> r = q.split_at(q.begin() + k);
+		if (r.get_rebalance() != sjtu::deque<long long>::lazy)
+			error();
+		std::deque<long long> dr(d.begin() + k, d.end());
+		d.erase(d.begin() + k, d.end());
+		r.splice_back(std::move(q));
+		d.insert(d.begin(), dr.begin(), dr.end());
+		q.splice_front(std::move(r));
+		if (!r.empty() || !same(q, d))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSplice();
+	TestSplit();
+	TestLazy();
+	std::cout << "Congratulations. Your deque splices and splits correctly." << std::endl;
+	return 0;
+}
@@ -0,0 +1,153 @@
+#include "class-integer.hpp"
+#include "class-matrix.hpp"
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 10005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool same(const sjtu::deque<T> &q, const std::deque<T> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	typename sjtu::deque<T>::const_iterator it = q.cbegin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (!(*it == d[i]) || !(q[i] == d[i]))
+			return false;
+	}
+	return it == q.cend();
+}
+
+void TestSnapshotIsolation()
+{
+	std::cout << "Test 1 : Test for snapshots not seeing later writes...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	for (long long i = 0; i < N; ++i) {
+		q.push_back(i);
+		d.push_back(i);
+	}
+	sjtu::deque<long long> snap;
+	snap.share(q);
+	std::deque<long long> dsnap(d);
+
+	q[0] = -1;
+	d[0] = -1;
+	*(q.begin() + 5000) = -2;
+	*(d.begin() + 5000) = -2;
+	for (long long i = 0; i < 3000; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.insert(q.begin() + pos, -i);
+		d.insert(d.begin() + pos, -i);
+		pos = randNum(i + 7, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+	}
+	if (!same(q, d) || !same(snap, dsnap))
+		error();
+
+	snap.pop_front();
+	dsnap.pop_front();
+	snap.push_back(233);
+	dsnap.push_back(233);
+	if (!same(q, d) || !same(snap, dsnap))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestChainedCopies()
+{
+	std::cout << "Test 2 : Test for snapshots of snapshots...";
+	sjtu::deque<Diamond::Matrix<double>> *p = new sjtu::deque<Diamond::Matrix<double>>;
+	std::vector<Diamond::Matrix<double>> v;
+	for (int i = 0; i < 2000; ++i) {
+		v.push_back(Diamond::Matrix<double>(randNum(i + 1, 7), randNum(i + 2, 7), i * 1.0));
+		p->push_back(v.back());
+	}
+	sjtu::deque<Diamond::Matrix<double>> a, b, c;
+	a.share(*p);
+	b.share(a);
+	c.share(b);
+	c.share(c);
+	delete p;
+	a.front();
+	b.erase(b.begin());
+	c.insert(c.begin() + 1000, v[0]);
+	for (int i = 0; i < 2000; ++i) {
+		if (!(a[i] == v[i]))
+			error();
+		if (i < 1999 && !(b[i] == v[i + 1]))
+			error();
+		if (!(c[i < 1000 ? i : i + 1] == v[i]))
+			error();
+	}
+	if (!(c[1000] == v[0]))
+		error();
+	a.share(b);
+	b.clear();
+	if (a.size() != 1999 || !(a[0] == v[1]) || !b.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int counter = 0;
+class Counted {
+public:
+	int x;
+	Counted(int x) : x(x) { counter++; }
+	Counted(const Counted &other) : x(other.x) { counter++; }
+	~Counted() { counter--; }
+};
+
+void TestNoElementCopies()
+{
+	std::cout << "Test 3 : Test for snapshots not copying elements...";
+	{
+		sjtu::deque<Counted> q;
+		for (int i = 0; i < N; ++i)
+			q.push_back(Counted(i));
+		sjtu::deque<Counted> snap, snap2;
+		snap.share(q);
+		snap2.share(snap);
+		if (counter != N)
+			error();
+		const sjtu::deque<Counted> &view = snap;
+		long long sum = 0;
+		for (size_t i = 0; i < view.size(); ++i)
+			sum += view[i].x;
+		if (counter != N || sum != (long long)N * (N - 1) / 2)
+			error();
+		q[N / 2].x = -1;
+		if (counter <= N || counter > N + sjtu::blockSize + 1 || view[N / 2].x != N / 2)
+			error();
+		snap2 = q;
+		if (snap2[N / 2].x != -1)
+			error();
+	}
+	if (counter != 0)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSnapshotIsolation();
+	TestChainedCopies();
+	TestNoElementCopies();
+	std::cout << "Congratulations. Your deque snapshots have passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,218 @@
+#include "class-integer.hpp"
+#include "class-matrix.hpp"
+#include <iostream>
+#include <deque>
+#include <cstdlib>
+#include <string>
+#include "../circular_buffer.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool same(const sjtu::circular_buffer<T> &c, const std::deque<T> &d)
+{
+	if (c.size() != d.size())
+		return false;
+	typename sjtu::circular_buffer<T>::const_iterator it = c.cbegin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		T x = *it, y = c[i];
+		if (!(x == d[i]) || !(y == d[i]))
+			return false;
+	}
+	return it == c.cend();
+}
+
+void TestOverwrite()
+{
+	std::cout << "Test 1 : Test for a sliding window overwriting the oldest...";
+	sjtu::circular_buffer<long long> c(1000);
+	std::deque<long long> d;
+	for (long long i = 0; i < N; ++i) {
+		long long x = randNum(i, N);
+		if (!c.push_back(x))
+			error();
+		d.push_back(x);
+		if (d.size() > 1000)
+			d.pop_front();
+		if (i % 7 == 0) {
+			c.pop_front();
+			d.pop_front();
+		}
+		if (!d.empty() && (c.front() != d.front() || c.back() != d.back()))
+			error();
+	}
+	if (!same(c, d))
+		error();
+	c.push_front(-1);
+	d.push_front(-1);
+	while (d.size() > 1000)
+		d.pop_back();
+	if (!same(c, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestReject()
+{
+	std::cout << "Test 2 : Test for rejecting when full...";
+	sjtu::circular_buffer<Integer> c(10, sjtu::circular_buffer<Integer>::reject);
+	std::deque<Integer> d;
+	for (int i = 0; i < 15; ++i) {
+		bool ok = c.push_back(Integer(i));
+		if (ok != (i < 10))
+			error();
+		if (ok)
+			d.push_back(Integer(i));
+	}
+	if (!c.full() || c.push_front(Integer(-1)) || !same(c, d))
+		error();
+	c.pop_back();
+	d.pop_back();
+	if (!c.push_front(Integer(-1)))
+		error();
+	d.push_front(Integer(-1));
+	if (!same(c, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSpans()
+{
+	std::cout << "Test 3 : Test for the two contiguous spans...";
+	sjtu::circular_buffer<int> c(8);
+	for (int round = 0; round < 40; ++round) {
+		c.push_back(round);
+		if (round % 3 == 0)
+			c.pop_front();
+		sjtu::pair<int *, size_t> a = c.array_one(), b = c.array_two();
+		if (a.second + b.second != c.size())
+			error();
+		size_t k = 0;
+		for (size_t i = 0; i < a.second; ++i, ++k) {
+			if (a.first[i] != c[k])
+				error();
+		}
+		for (size_t i = 0; i < b.second; ++i, ++k) {
+			if (b.first[i] != c[k])
+				error();
+		}
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCopyAndBounds()
+{
+	std::cout << "Test 4 : Test for copy, assignment and exceptions...";
+	sjtu::circular_buffer<Diamond::Matrix<double>> *p = new sjtu::circular_buffer<Diamond::Matrix<double>>(50);
+	std::deque<Diamond::Matrix<double>> d;
+	for (int i = 0; i < 120; ++i) {
+		Diamond::Matrix<double> m(randNum(i + 1, 7), randNum(i + 2, 7), i * 1.0);
+		p->push_back(m);
+		d.push_back(m);
+		if (d.size() > 50)
+			d.pop_front();
+	}
+	sjtu::circular_buffer<Diamond::Matrix<double>> a(*p), b(3);
+	b = a;
+	b = b;
+	delete p;
+	if (!same(a, d) || !same(b, d) || b.capacity() != 50)
+		error();
+
+	int caught = 0;
+	try { a.at(50); } catch (sjtu::index_out_of_bound) { caught++; }
+	a.clear();
+	try { a.front(); } catch (sjtu::container_is_empty) { caught++; }
+	try { a.pop_back(); } catch (sjtu::container_is_empty) { caught++; }
+	try { sjtu::circular_buffer<int> z(0); } catch (sjtu::runtime_error) { caught++; }
+	if (caught != 4 || !a.empty() || a.begin() != a.end())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int alive = 0, budget = -1;
+struct Fragile {
+	int v;
+	Fragile(int v = 0) : v(v) { alive++; }
+	Fragile(const Fragile &other) : v(other.v) {
+		if (budget == 0)
+			throw 1;
+		if (budget > 0)
+			budget--;
+		alive++;
+	}
+	Fragile &operator=(const Fragile &other) {
+		if (budget == 0)
+			throw 1;
+		if (budget > 0)
+			budget--;
+		v = other.v;
+		return *this;
+	}
+	~Fragile() { alive--; }
+};
+
+void TestSelfAndThrow()
+{
+	std::cout << "Test 5 : Test for overwriting with its own elements and throwing copies...";
+	sjtu::circular_buffer<std::string> c(3);
+	std::deque<std::string> d;
+	for (int i = 0; i < 3; ++i) {
+		std::string s(40, (char)('a' + i));
+		c.push_back(s);
+		d.push_back(s);
+	}
+	for (int i = 0; i < 10; ++i) {
+		c.push_back(c.front());
+		d.push_back(d.front());
+		d.pop_front();
+		c.push_front(c.back());
+		d.push_front(d.back());
+		d.pop_back();
+		if (!same(c, d))
+			error();
+	}
+
+	{
+		sjtu::circular_buffer<Fragile> f(4);
+		for (int i = 0; i < 4; ++i)
+			f.push_back(Fragile(i));
+		budget = 0;
+		int caught = 0;
+		try { f.push_back(Fragile(9)); } catch (int) { caught++; }
+		try { f.push_front(Fragile(9)); } catch (int) { caught++; }
+		budget = 2;
+		try { sjtu::circular_buffer<Fragile> g(f); } catch (int) { caught++; }
+		budget = -1;
+		if (caught != 3 || f.size() != 4 || alive != 4)
+			error();
+		for (int i = 0; i < 4; ++i)
+			if (f[i].v != i)
+				error();
+	}
+	if (alive != 0)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestOverwrite();
+	TestReject();
+	TestSpans();
+	TestCopyAndBounds();
+	TestSelfAndThrow();
+	std::cout << "Congratulations. Your circular buffer has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstdlib>
+#include "../deque.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+bool same(sjtu::deque<long long> &q, const std::deque<long long> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	sjtu::deque<long long>::iterator it = q.begin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (*it != d[i])
+			return false;
+	}
+	return it == q.end();
+}
+
+bool consistent(const sjtu::deque_report &r)
+{
+	size_t sum = 0;
+	for (int i = 0; i < 10; ++i)
+		sum += r.histogram[i];
+	return sum == r.blocks && r.used <= r.allocated && r.longestUnderfull <= r.blocks;
+}
+
+void TestReport()
+{
+	std::cout << "Test 1 : Test for the structure report...";
+	sjtu::deque<long long> q;
+	sjtu::deque_report r = q.report();
+	if (r.blocks != 1 || r.used != 0 || r.histogram[0] != 1 || r.longestUnderfull != 1 || !consistent(r))
+		error();
+
+	std::vector<long long> v(N, 1);
+	q.append(v.begin(), v.end());
+	r = q.report();
+	if (r.blocks != (N + sjtu::blockSize - 1) / sjtu::blockSize || r.histogram[9] != r.blocks - 1 || !consistent(r))
+		error();
+	if (r.used != N * (sizeof(long long) + sizeof(long long *)))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCompact()
+{
+	std::cout << "Test 2 : Test for compact after random erase...";
+	sjtu::deque<long long> q;
+	std::deque<long long> d;
+	for (long long i = 0; i < N; ++i) {
+		q.push_back(i);
+		d.push_back(i);
+	}
+	for (long long i = 0; i < N / 2; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.erase(q.begin() + pos);
+		d.erase(d.begin() + pos);
+	}
+	sjtu::deque_report before = q.report();
+
+	q.compact();
+	sjtu::deque_report after = q.report();
+	if (!same(q, d) || !consistent(after))
+		error();
+	if (after.blocks != (d.size() + sjtu::blockSize - 1) / sjtu::blockSize || after.allocated > before.allocated)
+		error();
+	if (after.longestUnderfull > 1 || after.histogram[9] != after.blocks - 1)
+		error();
+
+	q.compact(0.5);
+	after = q.report();
+	if (!same(q, d) || after.blocks != (d.size() + sjtu::blockSize / 2 - 1) / (sjtu::blockSize / 2))
+		error();
+
+	for (long long i = 0; i < 1000; ++i) {
+		int pos = randNum(i, d.size()) - 1;
+		q.insert(q.begin() + pos, -i);
+		d.insert(d.begin() + pos, -i);
+	}
+	if (!same(q, d))
+		error();
+
+	sjtu::deque<long long> snap;
+	snap.share(q);
+	q.compact();
+	if (!same(q, d) || !same(snap, d))
+		error();
+
+	q.clear();
+	q.compact();
+	if (!q.empty() || q.report().blocks != 1)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestShared()
+{
+	std::cout << "Test 3 : Test for the report of small and shared blocks...";
+	sjtu::deque<long long> q;
+	for (long long i = 0; i < 3; ++i)
+		q.push_back(i);
+	sjtu::deque_report r = q.report();
+	if (r.blocks != 1 || r.histogram[3 * 10 / sjtu::firstBlockSize] != 1 || r.shared != 0 || !consistent(r))
+		error();
+
+	std::vector<long long> v(N, 1);
+	q.append(v.begin(), v.end());
+	sjtu::deque_report alone = q.report();
+	sjtu::deque<long long> snap;
+	snap.share(q);
+	r = q.report();
+	sjtu::deque_report s = snap.report();
+	if (r.shared != r.blocks || s.shared != s.blocks || r.used != 0 || !consistent(r))
+		error();
+	if (r.sharedAllocated + r.allocated != alone.allocated || s.sharedAllocated != r.sharedAllocated)
+		error();
+
+	q.push_back(2);
+	r = q.report();
+	if (r.shared != r.blocks - 1 || r.used == 0 || !consistent(r) || snap.report().shared != r.shared)
+		error();
+	snap.clear();
+	r = q.report();
+	if (r.shared != 0 || r.sharedAllocated != 0 || r.used != q.size() * (sizeof(long long) + sizeof(long long *)))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestReport();
+	TestCompact();
+	TestShared();
+	std::cout << "Congratulations. Your deque report and compact have passed all correctness tests." << std::endl;
+	return 0;
+}
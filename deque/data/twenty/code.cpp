@@ -0,0 +1,122 @@
+#include <iostream>
+#include <deque>
+#include <string>
+#include <cstdlib>
+#include "../window_aggregator.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct concat {
+	std::string operator()(const std::string &a, const std::string &b) const {
+		return a + b;
+	}
+};
+
+template<class Op>
+long long fold(const std::deque<long long> &d, Op op)
+{
+	long long acc = d[0];
+	for (size_t i = 1; i < d.size(); ++i)
+		acc = op(acc, d[i]);
+	return acc;
+}
+
+template<class Op>
+void check(Op op, size_t window)
+{
+	sjtu::window_aggregator<long long, Op> w(op);
+	std::deque<long long> d;
+	for (size_t i = 0; i < N; ++i) {
+		long long x = randNum(i, 1000) * (i % 7 + 1);
+		w.push_back(x);
+		d.push_back(x);
+		if (d.size() > window || randNum(i, 13) == 1) {
+			w.pop_front();
+			d.pop_front();
+		}
+		if (w.size() != d.size())
+			error();
+		if (d.empty())
+			continue;
+		if (w.front() != d.front() || w.back() != d.back())
+			error();
+		if (i % 97 == 0 || window < 50) {
+			if (w.query() != fold(d, op))
+				error();
+		}
+	}
+}
+
+void TestWindows()
+{
+	std::cout << "Test 1 : Test for sum, min, max and gcd over sliding windows...";
+	size_t sizes[] = {1, 2, 17, 1000};
+	for (int k = 0; k < 4; ++k) {
+		check(std::plus<long long>(), sizes[k]);
+		check(sjtu::min_of<long long>(), sizes[k]);
+		check(sjtu::max_of<long long>(), sizes[k]);
+		check(sjtu::gcd_of<long long>(), sizes[k]);
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestOrder()
+{
+	std::cout << "Test 2 : Test for a non-commutative operation...";
+	sjtu::window_aggregator<std::string, concat> w;
+	std::deque<std::string> d;
+	for (int i = 0; i < 5000; ++i) {
+		std::string s(1, (char)('a' + randNum(i, 26) - 1));
+		w.push_back(s);
+		d.push_back(s);
+		while (d.size() > (size_t)(i % 40 + 1)) {
+			w.pop_front();
+			d.pop_front();
+		}
+		std::string all;
+		for (size_t j = 0; j < d.size(); ++j)
+			all += d[j];
+		if (w.query() != all)
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestEmpty()
+{
+	std::cout << "Test 3 : Test for exceptions and clear...";
+	sjtu::window_aggregator<int> w;
+	int caught = 0;
+	try { w.query(); } catch (sjtu::container_is_empty) { caught++; }
+	try { w.pop_front(); } catch (sjtu::container_is_empty) { caught++; }
+	w.push_back(3);
+	w.push_back(4);
+	w.pop_front();
+	if (w.query() != 4)
+		error();
+	w.clear();
+	try { w.front(); } catch (sjtu::container_is_empty) { caught++; }
+	if (caught != 3 || !w.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestWindows();
+	TestOrder();
+	TestEmpty();
+	std::cout << "Congratulations. Your window aggregator has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <deque>
+#include <memory>
+#include <cstdlib>
+#include "../deque.hpp"
+#include "../algorithm.hpp"
+
+long long randNum(long long x, long long maxNum)
+{
+	x = (x * 10007) % maxNum;
+	return x + 1;
+}
+const size_t N = 100005LL;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+typedef std::unique_ptr<long long> Ptr;
+
+bool same(sjtu::deque<Ptr> &q, const std::deque<long long> &d)
+{
+	if (q.size() != d.size())
+		return false;
+	sjtu::deque<Ptr>::iterator it = q.begin();
+	for (size_t i = 0; i < d.size(); ++i, ++it) {
+		if (**it != d[i] || *q[i] != d[i])
+			return false;
+	}
+	return it == q.end();
+}
+
+sjtu::deque<long long> build(size_t n)
+{
+	sjtu::deque<long long> q;
+	for (size_t i = 0; i < n; ++i)
+		q.push_back(i);
+	return q;
+}
+
+void TestMoveOnly()
+{
+	std::cout << "Test 1 : Test for a deque of move-only elements...";
+	sjtu::deque<Ptr> q;
+	std::deque<long long> d;
+	for (size_t i = 0; i < N; ++i) {
+		long long x = randNum(i, N);
+		Ptr p(new long long(x));
+		switch (i % 4) {
+			case 0:
+				q.push_back(std::move(p));
+				d.push_back(x);
+				break;
+			case 1:
+				q.push_front(std::move(p));
+				d.push_front(x);
+				break;
+			case 2: {
+				size_t k = randNum(i, d.size() + 1) - 1;
+				q.insert(q.begin() + k, std::move(p));
+				d.insert(d.begin() + k, x);
+				break;
+			}
+			case 3:
+				q.erase(q.begin() + d.size() / 2);
+				d.erase(d.begin() + d.size() / 2);
+				q.pop_back();
+				d.pop_back();
+				break;
+		}
+	}
+	if (!same(q, d))
+		error();
+
+	sjtu::deque<Ptr> r = q.split_at(q.begin() + d.size() / 3);
+	q.compact(0.7);
+	q.splice_back(std::move(r));
+	sjtu::sort(q, [](const Ptr &a, const Ptr &b) { return *a < *b; });
+	std::sort(d.begin(), d.end());
+	if (!r.empty() || !same(q, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestMoveDeque()
+{
+	std::cout << "Test 2 : Test for moving whole deques...";
+	sjtu::deque<long long> q = build(N);
+	const long long *first = &q[0], *last = &q[N - 1];
+
+	sjtu::deque<long long> m(std::move(q));
+	if (!q.empty() || m.size() != N || &m[0] != first || &m[N - 1] != last)
+		error();
+	q.push_back(5);
+	if (q.size() != 1 || q.front() != 5 || q.back() != 5)
+		error();
+
+	q = std::move(m);
+	if (!m.empty() || q.size() != N || &q[0] != first || *(q.end() - 1) != (long long)N - 1)
+		error();
+	m.push_front(1);
+	m = std::move(m);
+	if (m.size() != 1 || m.front() != 1)
+		error();
+
+	m.swap(q);
+	if (m.size() != N || q.size() != 1 || &m[N - 1] != last || q.back() != 1)
+		error();
+
+	sjtu::deque<sjtu::deque<long long> > nest;
+	for (int i = 0; i < 100; ++i)
+		nest.push_back(build(i));
+	nest.push_front(std::move(m));
+	if (nest.size() != 101 || nest.front().size() != N || &nest.front()[0] != first || !m.empty())
+		error();
+	for (int i = 0; i < 100; ++i) {
+		if (nest[i + 1].size() != (size_t)i || (i && nest[i + 1].back() != i - 1))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestMoveOnly();
+	TestMoveDeque();
+	std::cout << "Congratulations. Your deque moves correctly." << std::endl;
+	return 0;
+}
@@ -3,10 +3,36 @@
 
 #include "exceptions.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu {
     const int blockSize = 300;
+    const int firstBlockSize = 4;
+
+    /**
+     * how well the blocks of a deque are filled, see deque::report().
+     */
+    struct deque_report {
+        // number of blocks holding elements (the first block is counted even when empty)
+        size_t blocks;
+        // histogram[i] counts the blocks filled to [i / 10, (i + 1) / 10) of their own capacity,
+        // full blocks are counted in histogram[9]
+        size_t histogram[10];
+        // bytes taken by blocks, and by the pointer arrays and elements this deque alone owns
+        size_t allocated;
+        // bytes taken by the elements and the pointer slots in use, in blocks this deque alone owns
+        size_t used;
+        // number of blocks whose elements are shared with another deque (see share())
+        size_t shared;
+        // bytes taken by the pointer arrays and elements of those blocks, counted in no allocated
+        size_t sharedAllocated;
+        // the longest run of consecutive blocks holding less than blockSize / 2 elements
+        size_t longestUnderfull;
+    };
 
     template<class T>
     class deque {
@@ -14,72 +40,173 @@ namespace sjtu {
         friend class const_iterator;
 
     private:
+        /**
+         * the pointer array of a block may be shared by several deques (see share()),
+         * so every write goes through detach() first.
+         * ref is atomic so that a shared copy may be read and destroyed on another thread.
+         * a block holds at most cap elements between operations (one more transiently, before
+         * adjust() runs), cap grows geometrically from firstBlockSize up to blockSize.
+         * a block of capacity 0 owns no array at all, as the sentinel and an empty head do.
+         */
         struct Node {
             int size;
+            int cap;
             T **data;
+            std::atomic<int> *ref;
 
             Node *prev;
             Node *next;
 
-            Node() {
-                size = 0;
+            Node(int cap = 0) : size(0), cap(cap) {
                 prev = next = NULL;
-                data = new T *[blockSize + 1];
+                data = cap ? new T *[cap + 1] : NULL;
+                ref = cap ? new std::atomic<int>(1) : NULL;
             }
 
-            Node(const Node &other) {
-                size = other.size;
+            Node(const Node &other) : size(0), cap(other.cap) {
                 prev = next = NULL;
 
-                data = new T *[blockSize + 1];
-                for (int i = 0; i < other.size; ++i) {
-                    data[i] = new T(*other.data[i]);
+                data = cap ? new T *[cap + 1] : NULL;
+                ref = cap ? new std::atomic<int>(1) : NULL;
+                for (; size < other.size; ++size) {
+                    data[size] = new T(*other.data[size]);
                 }
             }
 
+            /**
+             * a block reading the same elements as other, nothing is copied.
+             */
+            Node(const Node *other) {
+                size = other->size;
+                cap = other->cap;
+                prev = next = NULL;
+
+                data = other->data;
+                ref = other->ref;
+                if (ref)
+                    ref->fetch_add(1);
+            }
+
             Node &operator=(const Node &other) {
                 if (this == &other)
                     return *this;
 
-                clear();
-
-                size = other.size;
+                release();
 
-                data = new T *[blockSize + 1];
-                for (int i = 0; i < other.size; ++i)
-                    data[i] = new T(*other.data[i]);
+                size = 0;
+                cap = other.cap;
+                data = cap ? new T *[cap + 1] : NULL;
+                ref = cap ? new std::atomic<int>(1) : NULL;
+                for (; size < other.size; ++size)
+                    data[size] = new T(*other.data[size]);
 
                 return *this;
             }
 
             ~Node() {
-                clear();
+                release();
+            }
+
+            void release() {
+                if (ref != NULL && ref->fetch_sub(1) == 1) {
+                    for (int i = 0; i < size; ++i) {
+                        delete data[i];
+                    }
+                    delete [] data;
+                    delete ref;
+                }
             }
 
-            void clear() {
-                for (int i = 0; i < size; ++i) {
-                    delete data[i];
+            /**
+             * makes this block the only owner of its elements.
+             */
+            void detach() {
+                if (ref == NULL || ref->load() == 1)
+                    return;
+
+                duplicate(std::is_copy_constructible<T>());
+            }
+
+            /**
+             * a block of a move-only T is never shared, since share() needs a copyable T.
+             */
+            void duplicate(std::false_type) {}
+
+            void duplicate(std::true_type) {
+                T **tmp = new T *[cap + 1];
+                int i = 0;
+                try {
+                    for (; i < size; ++i)
+                        tmp[i] = new T(*data[i]);
+                }
+                catch (...) {
+                    while (i > 0)
+                        delete tmp[--i];
+                    delete [] tmp;
+                    throw;
                 }
+
+                release();
+                data = tmp;
+                ref = new std::atomic<int>(1);
+            }
+
+            /**
+             * makes room for n elements, growing cap at least geometrically.
+             */
+            void reserve(int n) {
+                if (n <= cap)
+                    return;
+
+                int c = std::min(blockSize, std::max(firstBlockSize, cap * 2));
+                if (c < n)
+                    c = n;
+                detach();
+                T **tmp = new T *[c + 1];
+                for (int i = 0; i < size; ++i)
+                    tmp[i] = data[i];
                 delete [] data;
-                size = 0;
+                data = tmp;
+                cap = c;
+                if (ref == NULL)
+                    ref = new std::atomic<int>(1);
             }
 
             T &at(int idx) {
                 if (idx < 0 || idx >= size)
                     throw index_out_of_bound();
 
+                detach();
+                return *(data[idx]);
+            }
+
+            const T &at(int idx) const {
+                if (idx < 0 || idx >= size)
+                    throw index_out_of_bound();
+
                 return *(data[idx]);
             }
 
             void insert(int idx, const T &value) {
+                detach();
+                place(idx, new T(value));
+            }
+
+            void insert(int idx, T &&value) {
+                detach();
+                place(idx, new T(std::move(value)));
+            }
+
+            void place(int idx, T *tmp) {
                 for (int i = size; i > idx; --i)
                     data[i] = data[i - 1];
 
-                data[idx] = new T(value);
+                data[idx] = tmp;
                 size++;
             }
 
             void erase(int idx) {
+                detach();
                 delete data[idx];
 
                 for (size_t i = idx + 1; i < size; ++i)
@@ -90,30 +217,87 @@ namespace sjtu {
 
         };
 
+    public:
+        /**
+         * eager keeps every touched block at least half full, merging as many neighbours as needed.
+         * lazy lets blocks drift down to a quarter full and touches at most one neighbour per
+         * insert or erase, so no single operation pays for a cascade of merges;
+         * call compact() to repack when it suits you.
+         */
+        enum rebalance_policy {
+            eager,
+            lazy
+        };
+
+    private:
         int tot;
         Node *head, *tail;
+        Node sentinel;
+        rebalance_policy policy;
+
+        /**
+         * the block found by the last at() and the index of its first element,
+         * so that sequential and nearby accesses do not walk from head again.
+         * cleared by every change of the block structure.
+         */
+        Node *finger;
+        size_t fingerBase;
+
+        /**
+         * finds the block holding pos, walking from whichever of head, tail and the finger is nearest.
+         * n is set to the offset of pos in that block. pos must be less than tot.
+         */
+        Node *locate(size_t pos, int &n) const {
+            Node *p = head;
+            size_t base = 0;
+            size_t best = pos;
+            if ((size_t)tot - pos < best) {
+                p = tail;
+                base = tot;
+                best = tot - pos;
+            }
+            if (finger != NULL && (pos >= fingerBase ? pos - fingerBase : fingerBase - pos) < best) {
+                p = finger;
+                base = fingerBase;
+            }
+
+            while (pos < base) {
+                p = p->prev;
+                base -= p->size;
+            }
+            while (pos >= base + p->size) {
+                base += p->size;
+                p = p->next;
+            }
+            n = (int)(pos - base);
+            return p;
+        }
 
         void adjust(Node *node) {
             if (node == tail)
                 return;
 
-            if (node->size < blockSize / 2) {
-                merge(node);
-            }
-            else if (node->size > blockSize) {
+            if (node->size > blockSize) {
                 split(node);
             }
+            else if (node->size >= node->cap && node->cap < blockSize) {
+                node->reserve(node->size + 1);
+            }
+            else if (policy == lazy) {
+                if (node->size < blockSize / 4)
+                    mergeOnce(node);
+            }
+            else if (node->size < blockSize / 2) {
+                merge(node);
+            }
         }
 
         void merge(Node *node) {
             while (node->next != tail && node->size + node->next->size <= blockSize) {
-                while (node->next != tail && node->size == 0) {
-                    Node *p = node;
-                    node = node->next;
-                    delete p;
-                }
-
                 Node *p = node->next;
+                node->reserve(node->size + p->size);
+                node->detach();
+                p->detach();
                 for (int i = node->size; i < node->size + p->size; ++i) {
                     node->data[i] = p->data[i - node->size];
                 }
@@ -129,6 +313,9 @@ namespace sjtu {
             if (node->next != tail && node->size < blockSize / 2) {
                 Node *p = node->next;
                 int tmp = std::min(p->size, blockSize / 2 - node->size);
+                node->reserve(node->size + tmp);
+                node->detach();
+                p->detach();
 
                 for (int i = 0; i < tmp; ++i) {
                     node->data[node->size + i] = node->next->data[i];
@@ -137,6 +324,7 @@ namespace sjtu {
                 node->size += tmp;
                 int tmp2 = p->size - tmp;
                 if (tmp2 == 0) {
+                    p->size = 0;
                     node->next = p->next;
                     node->next->prev = node;
                     delete p;
@@ -151,8 +339,39 @@ namespace sjtu {
 
         }
 
+        /**
+         * the lazy counterpart of merge(): only the next block is touched, so it costs O(blockSize).
+         * the two blocks are merged if they fit in one, otherwise they are evened out.
+         */
+        void mergeOnce(Node *node) {
+            Node *p = node->next;
+            if (p == tail)
+                return;
+
+            node->reserve(std::min(blockSize, node->size + p->size));
+            node->detach();
+            p->detach();
+            if (node->size + p->size <= blockSize) {
+                for (int i = 0; i < p->size; ++i)
+                    node->data[node->size + i] = p->data[i];
+                node->size += p->size;
+                p->size = 0;
+                unlink(p);
+            }
+            else {
+                int tmp = (p->size - node->size) / 2;
+                for (int i = 0; i < tmp; ++i)
+                    node->data[node->size + i] = p->data[i];
+                for (int i = tmp; i < p->size; ++i)
+                    p->data[i - tmp] = p->data[i];
+                node->size += tmp;
+                p->size -= tmp;
+            }
+        }
+
         void split(Node *node) {
-            Node *p = new Node;
+            node->detach();
+            Node *p = new Node(blockSize);
             p->prev = node;
             p->next = node->next;
             node->next->prev = p;
@@ -166,6 +385,63 @@ namespace sjtu {
             node->size = tmp;
         }
 
+        Node *linkAfter(Node *node, int cap = blockSize) {
+            Node *p = new Node(cap);
+            p->prev = node;
+            p->next = node->next;
+            node->next->prev = p;
+            node->next = p;
+            return p;
+        }
+
+        void unlink(Node *node) {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            delete node;
+        }
+
+        /**
+         * forgets the current blocks without freeing them, after they have been moved elsewhere.
+         */
+        void reset() {
+            finger = NULL;
+            head = new Node();
+            head->next = tail;
+            tail->prev = head;
+            tot = 0;
+        }
+
+        /**
+         * returns node if it has room for one more element, growing it if it may still grow,
+         * or else a new full-sized block linked after it.
+         */
+        Node *room(Node *node) {
+            if (node->size < node->cap)
+                return node;
+            if (node->cap < blockSize) {
+                node->reserve(node->size + 1);
+                return node;
+            }
+            return linkAfter(node);
+        }
+
+        /**
+         * copies [first, last) behind the elements of node,
+         * filling every block up to blockSize before linking a new one.
+         * returns the last block written.
+         */
+        template<class InputIt>
+        Node *fill(Node *node, InputIt first, InputIt last) {
+            node->detach();
+            for (; first != last; ++first) {
+                node = room(node);
+                node->data[node->size] = new T(*first);
+                node->size++;
+                tot++;
+            }
+            return node;
+        }
+
     public:
         class const_iterator;
 
@@ -331,9 +607,10 @@ namespace sjtu {
             }
 
             /**
-             * TODO it->field
+             * the element, for it->field. like *it it may first copy a shared block, so it can throw.
              */
-            T *operator->() const noexcept {
+            T *operator->() const {
+                nod->detach();
                 return nod->data[idx];
             }
 
@@ -529,7 +806,8 @@ namespace sjtu {
              * TODO *it
              */
             const T &operator*() const {
-                return nod->at(idx);
+                const Node *p = nod;
+                return p->at(idx);
             }
 
             /**
@@ -572,14 +850,124 @@ namespace sjtu {
             }
         };
 
+        /**
+         * walks the deque one block at a time.
+         * every block is a contiguous array of element pointers [begin(), end()),
+         * so a loop over it needs neither the block-boundary check of iterator++
+         * nor the bounds check of *it.
+         * the pointers stay valid until the next insert or erase.
+         */
+        class segment_iterator {
+            friend class deque;
+        private:
+            deque *deq;
+            Node *nod;
+
+        public:
+            segment_iterator(deque *deq = NULL, Node *nod = NULL) : deq(deq), nod(nod) {}
+
+            T **begin() const {
+                nod->detach();
+                return nod->data;
+            }
+
+            T **end() const {
+                nod->detach();
+                return nod->data + nod->size;
+            }
+
+            int size() const {
+                return nod->size;
+            }
+
+            /**
+             * the iterator pointing to the idx-th element of this block.
+             */
+            iterator at(int idx) const {
+                if (idx == nod->size)
+                    return iterator(deq, nod->next, 0);
+                return iterator(deq, nod, idx);
+            }
+
+            segment_iterator &operator++() {
+                nod = nod->next;
+                return *this;
+            }
+
+            segment_iterator operator++(int) {
+                segment_iterator ret = *this;
+                nod = nod->next;
+                return ret;
+            }
+
+            bool operator==(const segment_iterator &rhs) const {
+                return nod == rhs.nod;
+            }
+
+            bool operator!=(const segment_iterator &rhs) const {
+                return nod != rhs.nod;
+            }
+        };
+
+        class const_segment_iterator {
+            friend class deque;
+        private:
+            const deque *deq;
+            const Node *nod;
+
+        public:
+            const_segment_iterator(const deque *deq = NULL, const Node *nod = NULL) : deq(deq), nod(nod) {}
+
+            const_segment_iterator(const segment_iterator &other) : deq(other.deq), nod(other.nod) {}
+
+            const T *const *begin() const {
+                return nod->data;
+            }
+
+            const T *const *end() const {
+                return nod->data + nod->size;
+            }
+
+            int size() const {
+                return nod->size;
+            }
+
+            const_iterator at(int idx) const {
+                if (idx == nod->size)
+                    return const_iterator(deq, nod->next, 0);
+                return const_iterator(deq, const_cast<Node *>(nod), idx);
+            }
+
+            const_segment_iterator &operator++() {
+                nod = nod->next;
+                return *this;
+            }
+
+            const_segment_iterator operator++(int) {
+                const_segment_iterator ret = *this;
+                nod = nod->next;
+                return ret;
+            }
+
+            bool operator==(const const_segment_iterator &rhs) const {
+                return nod == rhs.nod;
+            }
+
+            bool operator!=(const const_segment_iterator &rhs) const {
+                return nod != rhs.nod;
+            }
+        };
+
         /**
          * TODO Constructors
          */
         deque() {
             tot = 0;
+            policy = eager;
+            finger = NULL;
 
             head = new Node();
-            tail = new Node();
+            tail = &sentinel;
 
             head->next = tail;
             tail->prev = head;
@@ -587,9 +975,11 @@ namespace sjtu {
 
         deque(const deque &other) {
             tot = other.tot;
+            policy = other.policy;
+            finger = NULL;
 
             head = new Node(*other.head);
-            tail = new Node();
+            tail = &sentinel;
             Node *p = head;
             Node *q = other.head->next;
             while (q != other.tail) {
@@ -603,13 +993,19 @@ namespace sjtu {
 
         }
 
+        /**
+         * takes the blocks of other, which is left empty. only a fresh empty block is allocated.
+         */
+        deque(deque &&other) : deque() {
+            swap(other);
+        }
+
         /**
          * TODO Deconstructor
          */
         ~deque() {
             clear();
             delete head;
-            delete tail;
         }
 
         /**
@@ -621,6 +1017,7 @@ namespace sjtu {
 
             clear();
             tot = other.tot;
+            policy = other.policy;
             delete head;
             head = new Node(*other.head);
 
@@ -638,36 +1035,72 @@ namespace sjtu {
         }
 
         /**
-         * access specified element with bounds checking
-         * throw index_out_of_bound if out of bound.
+         * frees the elements of this deque and takes those of other, which is left empty.
          */
-        T &at(const size_t &pos) {
-            Node *p = head;
-            int n = pos;
+        deque &operator=(deque &&other) noexcept {
+            if (this == &other)
+                return *this;
 
-            while (p != tail && n >= p->size) {
-                n -= p->size;
+            clear();
+            swap(other);
+            return *this;
+        }
+
+        /**
+         * makes this deque a snapshot of other: every block is shared, no element is copied,
+         * so it costs O(blocks) instead of O(n).
+         * a block is duplicated only when one of the deques first writes to it,
+         * reading the snapshot through const access never copies.
+         */
+        deque &share(const deque &other) {
+            static_assert(std::is_copy_constructible<T>::value, "share() needs a copyable T");
+            if (this == &other)
+                return *this;
+
+            clear();
+            tot = other.tot;
+            policy = other.policy;
+            delete head;
+            head = new Node(other.head);
+
+            Node *p = head, *q = other.head->next;
+            while (q != other.tail) {
+                p->next = new Node(q);
+                p->next->prev = p;
                 p = p->next;
+                q = q->next;
             }
+            p->next = tail;
+            tail->prev = p;
 
-            if (p == tail)
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if out of bound.
+         */
+        T &at(const size_t &pos) {
+            if (pos >= (size_t)tot)
                 throw index_out_of_bound();
 
+            int n;
+            Node *p = locate(pos, n);
+            finger = p;
+            fingerBase = pos - n;
             return p->at(n);
         }
 
+        /**
+         * uses the finger left by the non-const at() but never moves it,
+         * so concurrent readers of a const deque do not race.
+         */
         const T &at(const size_t &pos) const {
-            Node *p = head;
-            int n = pos;
-
-            while (p != tail && n >= p->size) {
-                n -= p->size;
-                p = p->next;
-            }
-
-            if (p == tail)
+            if (pos >= (size_t)tot)
                 throw index_out_of_bound();
 
+            int n;
+            const Node *p = locate(pos, n);
             return p->at(n);
         }
 
@@ -687,7 +1120,8 @@ namespace sjtu {
             if (empty())
                 throw container_is_empty();
 
-            return head->at(0);
+            const Node *p = head;
+            return p->at(0);
         }
 
         /**
@@ -698,7 +1132,8 @@ namespace sjtu {
             if (empty())
                 throw container_is_empty();
 
-            return tail->prev->at(tail->prev->size - 1);
+            const Node *p = tail->prev;
+            return p->at(p->size - 1);
         }
 
         /**
@@ -729,6 +1164,25 @@ namespace sjtu {
             return const_iterator(this, tail, 0);
         }
 
+        /**
+         * the first block and the one past the last block, see segment_iterator.
+         */
+        segment_iterator segment_begin() {
+            return segment_iterator(this, head);
+        }
+
+        segment_iterator segment_end() {
+            return segment_iterator(this, tail);
+        }
+
+        const_segment_iterator csegment_begin() const {
+            return const_segment_iterator(this, head);
+        }
+
+        const_segment_iterator csegment_end() const {
+            return const_segment_iterator(this, tail);
+        }
+
         /**
          * checks whether the container is empty.
          */
@@ -747,10 +1201,13 @@ namespace sjtu {
          * clears the contents
          */
         void clear() {
+            finger = NULL;
             Node *p = head->next;
             Node *q;
-            delete head;
-            head = new Node();
+            head->release();
+            head->size = head->cap = 0;
+            head->data = NULL;
+            head->ref = NULL;
             head->next = tail;
             tail->prev = head;
             while (p->next) {
@@ -762,14 +1219,134 @@ namespace sjtu {
         }
 
         /**
-         * inserts elements at the specified locat on in the container.
-         * inserts value before pos
-         * returns an iterator pointing to the inserted value
+         * exchanges the contents with other in O(1), nothing is allocated.
+         * iterators keep pointing into the blocks they pointed to but are no longer usable
+         * with the other deque.
+         */
+        void swap(deque &other) noexcept {
+            if (this == &other)
+                return;
+
+            Node *a = tail->prev, *b = other.tail->prev;
+            std::swap(head, other.head);
+            std::swap(tot, other.tot);
+            std::swap(policy, other.policy);
+            std::swap(finger, other.finger);
+            std::swap(fingerBase, other.fingerBase);
+
+            b->next = tail;
+            tail->prev = b;
+            a->next = other.tail;
+            other.tail->prev = a;
+        }
+
+        void set_rebalance(rebalance_policy p) {
+            policy = p;
+        }
+
+        rebalance_policy get_rebalance() const {
+            return policy;
+        }
+
+        /**
+         * returns block count, fill histogram, memory use and the longest run of underfull blocks.
+         * blocks still shared with another deque are counted apart, so that summing the reports
+         * of several deques counts their memory once.
+         * O(blocks), nothing is modified.
+         */
+        deque_report report() const {
+            deque_report ret;
+            ret.blocks = 0;
+            for (int i = 0; i < 10; ++i)
+                ret.histogram[i] = 0;
+            ret.allocated = sizeof(deque);
+            ret.used = 0;
+            ret.shared = 0;
+            ret.sharedAllocated = 0;
+            ret.longestUnderfull = 0;
+
+            size_t run = 0;
+            for (const Node *p = head; p != tail; p = p->next) {
+                ret.blocks++;
+                ret.histogram[p->cap ? std::min(9, p->size * 10 / p->cap) : 0]++;
+                ret.allocated += sizeof(Node);
+                size_t bytes = p->size * sizeof(T);
+                if (p->cap)
+                    bytes += (p->cap + 1) * sizeof(T *) + sizeof(std::atomic<int>);
+                if (p->ref != NULL && p->ref->load() > 1) {
+                    ret.shared++;
+                    ret.sharedAllocated += bytes;
+                }
+                else {
+                    ret.allocated += bytes;
+                    ret.used += p->size * (sizeof(T) + sizeof(T *));
+                }
+
+                if (p->size < blockSize / 2) {
+                    run++;
+                    ret.longestUnderfull = std::max(ret.longestUnderfull, run);
+                }
+                else {
+                    run = 0;
+                }
+            }
+            return ret;
+        }
+
+        /**
+         * repacks the elements so that every block but the last holds fill * blockSize of them,
+         * and frees the blocks no longer needed.
+         * elements are not copied or moved, only their pointers; iterators are invalidated.
+         */
+        void compact(double fill = 1.0) {
+            int per = (int)(fill * blockSize);
+            if (per < 1)
+                per = 1;
+            if (per > blockSize)
+                per = blockSize;
+            finger = NULL;
+
+            T **all = new T *[tot + 1];
+            size_t k = 0;
+            for (Node *p = head; p != tail; p = p->next) {
+                p->detach();
+                for (int i = 0; i < p->size; ++i)
+                    all[k++] = p->data[i];
+            }
+
+            Node *p = head;
+            size_t i = 0;
+            while (true) {
+                int n = (int)std::min((size_t)per, tot - i);
+                p->reserve(n);
+                for (int j = 0; j < n; ++j)
+                    p->data[j] = all[i + j];
+                p->size = n;
+                i += n;
+                if (i == (size_t)tot)
+                    break;
+                if (p->next == tail)
+                    linkAfter(p, per);
+                p = p->next;
+            }
+            while (p->next != tail) {
+                p->next->size = 0;
+                unlink(p->next);
+            }
+
+            delete [] all;
+        }
+
+    private:
+        /**
+         * the block and offset where an element inserted before pos goes,
+         * with the block already adjusted to take it.
          *     throw if the iterator is invalid or it point to a wrong place.
          */
-        iterator insert(iterator pos, const T &value) {
+        iterator slot(iterator pos) {
             if (this != pos.deq)
                 throw invalid_iterator();
+            finger = NULL;
 
             if (pos.nod->prev != NULL && pos.idx == 0) {
                 pos = iterator(this, pos.nod->prev, pos.nod->prev->size);
@@ -785,12 +1362,32 @@ namespace sjtu {
             if (pos.nod == tail)
                 throw index_out_of_bound();
 
+            return pos;
+        }
+
+    public:
+        /**
+         * inserts elements at the specified locat on in the container.
+         * inserts value before pos
+         * returns an iterator pointing to the inserted value
+         *     throw if the iterator is invalid or it point to a wrong place.
+         */
+        iterator insert(iterator pos, const T &value) {
+            pos = slot(pos);
             pos.nod->insert(pos.idx, value);
 
             tot++;
             return pos;
         }
 
+        iterator insert(iterator pos, T &&value) {
+            pos = slot(pos);
+            pos.nod->insert(pos.idx, std::move(value));
+
+            tot++;
+            return pos;
+        }
+
         /**
          * removes specified element at pos.
          * removes the element at pos.
@@ -800,6 +1397,7 @@ namespace sjtu {
         iterator erase(iterator pos) {
             if (this != pos.deq || pos.nod == tail)
                 throw invalid_iterator();
+            finger = NULL;
 
             while (pos.idx < 0) {
                 pos.nod = pos.nod->prev;
@@ -818,8 +1416,11 @@ namespace sjtu {
 
             pos.nod->erase(pos.idx);
             if (pos.idx == pos.nod->size) {
+                Node *p = pos.nod;
                 pos.idx = 0;
                 pos.nod = pos.nod->next;
+                if (p->size == 0 && p != head)
+                    unlink(p);
             }
             tot--;
 
@@ -833,6 +1434,10 @@ namespace sjtu {
             insert(iterator(this, tail->prev, tail->prev->size), value);
         }
 
+        void push_back(T &&value) {
+            insert(iterator(this, tail->prev, tail->prev->size), std::move(value));
+        }
+
         /**
          * removes the last element
          *     throw when the container is empty.
@@ -851,6 +1456,10 @@ namespace sjtu {
             insert(iterator(this, head, 0), value);
         }
 
+        void push_front(T &&value) {
+            insert(iterator(this, head, 0), std::move(value));
+        }
+
         /**
          * removes the first element.
          *     throw when the container is empty.
@@ -861,6 +1470,191 @@ namespace sjtu {
 
             erase(iterator(this, head, 0));
         }
+
+        /**
+         * inserts the elements of [first, last) before pos.
+         * whole blocks are filled and linked in one pass,
+         * then the last block written and the rest of the split block are rebalanced by the policy:
+         * eager merges them with as many following blocks as fit, lazy touches just the two.
+         * returns an iterator pointing to the first inserted element, or pos if the range is empty.
+         *     throw if the iterator is invalid or it point to a wrong place.
+         */
+        template<class InputIt>
+        iterator insert(iterator pos, InputIt first, InputIt last) {
+            if (this != pos.deq)
+                throw invalid_iterator();
+
+            Node *p = pos.nod;
+            int idx = pos.idx;
+            if (p == tail) {
+                p = tail->prev;
+                idx = p->size;
+            }
+            if (idx > p->size)
+                throw index_out_of_bound();
+            if (first == last)
+                return iterator(this, p, idx);
+
+            finger = NULL;
+            p->detach();
+            Node *rest = linkAfter(p, std::min(blockSize, p->size - idx));
+            for (int i = idx; i < p->size; ++i)
+                rest->data[i - idx] = p->data[i];
+            rest->size = p->size - idx;
+            p->size = idx;
+
+            Node *q = fill(p, first, last);
+            iterator ret = idx < p->size ? iterator(this, p, idx) : iterator(this, p->next, 0);
+
+            if (rest->size == 0)
+                unlink(rest);
+            else if (policy == eager)
+                merge(q);
+            else if (q->size < blockSize / 4 || rest->size < blockSize / 4)
+                mergeOnce(q);
+
+            return ret;
+        }
+
+        /**
+         * adds the elements of [first, last) to the end.
+         */
+        template<class InputIt>
+        void append(InputIt first, InputIt last) {
+            finger = NULL;
+            fill(tail->prev, first, last);
+        }
+
+        /**
+         * adds the elements of [first, last) to the beginning, keeping their order.
+         */
+        template<class InputIt>
+        void prepend(InputIt first, InputIt last) {
+            insert(iterator(this, head, 0), first, last);
+        }
+
+        /**
+         * replaces the contents with n copies of value.
+         */
+        void assign(size_t n, const T &value) {
+            clear();
+
+            Node *p = head;
+            for (size_t i = 0; i < n; ++i) {
+                p = room(p);
+                p->data[p->size] = new T(value);
+                p->size++;
+                tot++;
+            }
+        }
+
+        /**
+         * moves all elements of other to the end, leaving other empty.
+         * the blocks of other are relinked, not copied, so it costs O(blockSize):
+         * only the block at the seam is rebalanced.
+         */
+        void splice_back(deque &&other) {
+            if (this == &other || other.tot == 0)
+                return;
+            finger = NULL;
+            if (tot == 0) {
+                delete head;
+                head = other.head;
+                other.tail->prev->next = tail;
+                tail->prev = other.tail->prev;
+                tot = other.tot;
+                other.reset();
+                return;
+            }
+
+            Node *seam = tail->prev;
+            seam->next = other.head;
+            other.head->prev = seam;
+            other.tail->prev->next = tail;
+            tail->prev = other.tail->prev;
+            tot += other.tot;
+            other.reset();
+
+            adjust(seam);
+        }
+
+        /**
+         * moves all elements of other to the beginning, keeping their order and leaving other empty.
+         * the blocks of other are relinked, not copied.
+         */
+        void splice_front(deque &&other) {
+            if (this == &other || other.tot == 0)
+                return;
+            if (tot == 0) {
+                splice_back(std::move(other));
+                return;
+            }
+            finger = NULL;
+
+            Node *seam = other.tail->prev;
+            seam->next = head;
+            head->prev = seam;
+            head = other.head;
+            tot += other.tot;
+            other.reset();
+
+            adjust(seam);
+        }
+
+        /**
+         * removes the elements from pos to the end and returns them as a new deque.
+         * whole blocks are relinked, only the block containing pos is cut in two,
+         * so it costs O(blocks + blockSize). pos and the iterators after it are invalidated.
+         *     throw if the iterator is invalid or it point to a wrong place.
+         */
+        deque split_at(iterator pos) {
+            if (this != pos.deq)
+                throw invalid_iterator();
+
+            while (pos.nod != tail && pos.idx >= pos.nod->size) {
+                pos.idx -= pos.nod->size;
+                pos.nod = pos.nod->next;
+            }
+
+            deque ret;
+            ret.policy = policy;
+            if (pos.nod == tail)
+                return ret;
+
+            finger = NULL;
+            Node *first = pos.nod;
+            if (pos.idx > 0) {
+                first->detach();
+                Node *rest = linkAfter(first, std::min(blockSize, first->size - pos.idx));
+                for (int i = pos.idx; i < first->size; ++i)
+                    rest->data[i - pos.idx] = first->data[i];
+                rest->size = first->size - pos.idx;
+                first->size = pos.idx;
+                first = rest;
+            }
+
+            Node *last = tail->prev;
+            for (Node *p = first; p != tail; p = p->next)
+                ret.tot += p->size;
+            tot -= ret.tot;
+
+            if (first == head) {
+                reset();
+            }
+            else {
+                first->prev->next = tail;
+                tail->prev = first->prev;
+            }
+
+            delete ret.head;
+            ret.head = first;
+            first->prev = NULL;
+            last->next = ret.tail;
+            ret.tail->prev = last;
+
+            ret.adjust(ret.head);
+            return ret;
+        }
     };
 
 }
@@ -0,0 +1,762 @@
+#ifndef SJTU_ROPE_HPP
+#define SJTU_ROPE_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+
+namespace sjtu {
+    /**
+     * a sequence container made of the same blocks as deque,
+     * but the blocks are the leaves of a counted B+ tree.
+     * every node knows how many elements live under it,
+     * so indexing, insert and erase at any position cost O(log n + leafSize).
+     * leaves are also linked in a list, so iterating is as cheap as in deque.
+     */
+    template<class T>
+    class rope {
+    private:
+        static const int leafSize = 300;
+        static const int fanout = 32;
+
+        struct Inner;
+
+        struct Base {
+            size_t cnt;
+            Inner *father;
+            bool leaf;
+
+            Base(bool leaf) : cnt(0), father(NULL), leaf(leaf) {}
+        };
+
+        struct Leaf : Base {
+            T **data;
+            Leaf *prev, *next;
+
+            Leaf() : Base(true) {
+                prev = next = NULL;
+                data = new T *[leafSize + 1];
+            }
+
+            ~Leaf() {
+                for (size_t i = 0; i < this->cnt; ++i)
+                    delete data[i];
+                delete [] data;
+            }
+        };
+
+        struct Inner : Base {
+            int num;
+            Base *son[fanout + 1];
+
+            Inner() : Base(false), num(0) {}
+        };
+
+        Base *root;
+        Leaf *first, *last;
+
+        static int indexOf(const Inner *f, const Base *t) {
+            int i = 0;
+            while (f->son[i] != t)
+                ++i;
+            return i;
+        }
+
+        /**
+         * find the leaf holding the pos-th element,
+         * pos becomes the offset inside that leaf.
+         * pos == size() resolves to the end of the last leaf.
+         */
+        Leaf *locate(size_t &pos) const {
+            Base *t = root;
+            while (!t->leaf) {
+                Inner *p = static_cast<Inner *>(t);
+                int i = 0;
+                while (i < p->num - 1 && pos >= p->son[i]->cnt) {
+                    pos -= p->son[i]->cnt;
+                    ++i;
+                }
+                t = p->son[i];
+            }
+            return static_cast<Leaf *>(t);
+        }
+
+        size_t indexOf(const Leaf *nod, int idx) const {
+            size_t ret = idx;
+            const Base *t = nod;
+            while (t->father != NULL) {
+                const Inner *f = t->father;
+                for (int i = 0; f->son[i] != t; ++i)
+                    ret += f->son[i]->cnt;
+                t = f;
+            }
+            return ret;
+        }
+
+        void addCount(Base *t, long long delta) {
+            while (t != NULL) {
+                t->cnt += delta;
+                t = t->father;
+            }
+        }
+
+        void insertSon(Base *t, Base *s) {
+            Inner *f = t->father;
+            if (f == NULL) {
+                f = new Inner;
+                f->son[0] = t;
+                f->son[1] = s;
+                f->num = 2;
+                f->cnt = t->cnt + s->cnt;
+                t->father = s->father = f;
+                root = f;
+                return;
+            }
+
+            int idx = indexOf(f, t);
+            for (int i = f->num; i > idx + 1; --i)
+                f->son[i] = f->son[i - 1];
+            f->son[idx + 1] = s;
+            f->num++;
+            s->father = f;
+
+            if (f->num > fanout)
+                splitInner(f);
+        }
+
+        void splitLeaf(Leaf *p) {
+            Leaf *q = new Leaf;
+            int tmp = p->cnt / 2;
+            for (size_t i = tmp; i < p->cnt; ++i)
+                q->data[i - tmp] = p->data[i];
+            q->cnt = p->cnt - tmp;
+            p->cnt = tmp;
+
+            q->prev = p;
+            q->next = p->next;
+            if (p->next != NULL)
+                p->next->prev = q;
+            else
+                last = q;
+            p->next = q;
+
+            insertSon(p, q);
+        }
+
+        void splitInner(Inner *p) {
+            Inner *q = new Inner;
+            int tmp = p->num / 2;
+            for (int i = tmp; i < p->num; ++i) {
+                q->son[i - tmp] = p->son[i];
+                q->son[i - tmp]->father = q;
+                q->cnt += p->son[i]->cnt;
+            }
+            q->num = p->num - tmp;
+            p->num = tmp;
+            p->cnt -= q->cnt;
+
+            insertSon(p, q);
+        }
+
+        void removeSon(Inner *f, Base *s) {
+            int idx = indexOf(f, s);
+            for (int i = idx + 1; i < f->num; ++i)
+                f->son[i - 1] = f->son[i];
+            f->num--;
+
+            if (f == root) {
+                if (f->num == 1) {
+                    root = f->son[0];
+                    root->father = NULL;
+                    delete f;
+                }
+            }
+            else if (f->num < fanout / 2) {
+                fixInner(f);
+            }
+        }
+
+        void fixLeaf(Leaf *p) {
+            Inner *f = p->father;
+            int idx = indexOf(f, p);
+            Leaf *l, *r;
+            if (idx + 1 < f->num) {
+                l = p;
+                r = static_cast<Leaf *>(f->son[idx + 1]);
+            }
+            else {
+                l = static_cast<Leaf *>(f->son[idx - 1]);
+                r = p;
+            }
+
+            if (l->cnt + r->cnt <= (size_t)leafSize) {
+                for (size_t i = 0; i < r->cnt; ++i)
+                    l->data[l->cnt + i] = r->data[i];
+                l->cnt += r->cnt;
+                r->cnt = 0;
+
+                l->next = r->next;
+                if (r->next != NULL)
+                    r->next->prev = l;
+                else
+                    last = l;
+
+                removeSon(f, r);
+                delete r;
+            }
+            else if (l->cnt < r->cnt) {
+                int tmp = (r->cnt - l->cnt) / 2;
+                for (int i = 0; i < tmp; ++i)
+                    l->data[l->cnt + i] = r->data[i];
+                for (size_t i = tmp; i < r->cnt; ++i)
+                    r->data[i - tmp] = r->data[i];
+                l->cnt += tmp;
+                r->cnt -= tmp;
+            }
+            else {
+                int tmp = (l->cnt - r->cnt) / 2;
+                for (int i = r->cnt - 1; i >= 0; --i)
+                    r->data[i + tmp] = r->data[i];
+                for (int i = 0; i < tmp; ++i)
+                    r->data[i] = l->data[l->cnt - tmp + i];
+                l->cnt -= tmp;
+                r->cnt += tmp;
+            }
+        }
+
+        void fixInner(Inner *p) {
+            Inner *f = p->father;
+            int idx = indexOf(f, p);
+            Inner *l, *r;
+            if (idx + 1 < f->num) {
+                l = p;
+                r = static_cast<Inner *>(f->son[idx + 1]);
+            }
+            else {
+                l = static_cast<Inner *>(f->son[idx - 1]);
+                r = p;
+            }
+
+            if (l->num + r->num <= fanout) {
+                for (int i = 0; i < r->num; ++i) {
+                    l->son[l->num + i] = r->son[i];
+                    r->son[i]->father = l;
+                }
+                l->num += r->num;
+                l->cnt += r->cnt;
+                r->num = 0;
+
+                removeSon(f, r);
+                delete r;
+            }
+            else if (l->num < r->num) {
+                int tmp = (r->num - l->num) / 2;
+                size_t moved = 0;
+                for (int i = 0; i < tmp; ++i) {
+                    l->son[l->num + i] = r->son[i];
+                    r->son[i]->father = l;
+                    moved += r->son[i]->cnt;
+                }
+                for (int i = tmp; i < r->num; ++i)
+                    r->son[i - tmp] = r->son[i];
+                l->num += tmp;
+                r->num -= tmp;
+                l->cnt += moved;
+                r->cnt -= moved;
+            }
+            else {
+                int tmp = (l->num - r->num) / 2;
+                size_t moved = 0;
+                for (int i = r->num - 1; i >= 0; --i)
+                    r->son[i + tmp] = r->son[i];
+                for (int i = 0; i < tmp; ++i) {
+                    r->son[i] = l->son[l->num - tmp + i];
+                    r->son[i]->father = r;
+                    moved += r->son[i]->cnt;
+                }
+                l->num -= tmp;
+                r->num += tmp;
+                l->cnt -= moved;
+                r->cnt += moved;
+            }
+        }
+
+        void makeEmpty(Base *t) {
+            if (t->leaf) {
+                delete static_cast<Leaf *>(t);
+                return;
+            }
+            Inner *p = static_cast<Inner *>(t);
+            for (int i = 0; i < p->num; ++i)
+                makeEmpty(p->son[i]);
+            delete p;
+        }
+
+        Base *copy(const Base *t, Inner *fa, Leaf *&tailLeaf) {
+            if (t->leaf) {
+                const Leaf *q = static_cast<const Leaf *>(t);
+                Leaf *p = new Leaf;
+                for (size_t i = 0; i < q->cnt; ++i) {
+                    p->data[i] = new T(*q->data[i]);
+                    p->cnt++;
+                }
+                p->father = fa;
+                p->prev = tailLeaf;
+                if (tailLeaf != NULL)
+                    tailLeaf->next = p;
+                else
+                    first = p;
+                tailLeaf = p;
+                return p;
+            }
+
+            const Inner *q = static_cast<const Inner *>(t);
+            Inner *p = new Inner;
+            p->father = fa;
+            p->cnt = q->cnt;
+            for (int i = 0; i < q->num; ++i) {
+                p->son[i] = copy(q->son[i], p, tailLeaf);
+                p->num++;
+            }
+            return p;
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator {
+            friend class rope;
+            friend class const_iterator;
+        private:
+            rope *rp;
+            Leaf *nod;
+            int idx;
+
+        public:
+            iterator(rope *rp = NULL, Leaf *nod = NULL, int idx = 0) : rp(rp), nod(nod), idx(idx) {}
+
+            iterator(const iterator &rhs) : rp(rhs.rp), nod(rhs.nod), idx(rhs.idx) {}
+
+            /**
+             * jumps go through the counted tree, O(log n) instead of walking blocks.
+             */
+            iterator operator+(const int &n) const {
+                long long pos = (long long)rp->index(*this) + n;
+                if (pos < 0 || pos > (long long)rp->size())
+                    throw index_out_of_bound();
+                return rp->iteratorAt(pos);
+            }
+
+            iterator operator-(const int &n) const {
+                return operator+(-n);
+            }
+
+            int operator-(const iterator &rhs) const {
+                if (rp != rhs.rp)
+                    throw invalid_iterator();
+                return (int)rp->index(*this) - (int)rp->index(rhs);
+            }
+
+            iterator operator+=(const int &n) {
+                *this = (*this) + n;
+                return *this;
+            }
+
+            iterator operator-=(const int &n) {
+                *this = (*this) - n;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            iterator &operator++() {
+                if (nod == NULL)
+                    throw invalid_iterator();
+                if (++idx == (int)nod->cnt) {
+                    nod = nod->next;
+                    idx = 0;
+                }
+                return *this;
+            }
+
+            iterator operator--(int) {
+                iterator ret = *this;
+                --(*this);
+                return ret;
+            }
+
+            iterator &operator--() {
+                if (nod == NULL) {
+                    if (rp->empty())
+                        throw invalid_iterator();
+                    nod = rp->last;
+                    idx = nod->cnt - 1;
+                }
+                else if (idx == 0) {
+                    if (nod->prev == NULL)
+                        throw invalid_iterator();
+                    nod = nod->prev;
+                    idx = nod->cnt - 1;
+                }
+                else {
+                    idx--;
+                }
+                return *this;
+            }
+
+            T &operator*() const {
+                if (nod == NULL)
+                    throw invalid_iterator();
+                return *(nod->data[idx]);
+            }
+
+            T *operator->() const noexcept {
+                return nod->data[idx];
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return rp == rhs.rp && nod == rhs.nod && idx == rhs.idx;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return rp == rhs.rp && nod == rhs.nod && idx == rhs.idx;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+        };
+
+        class const_iterator {
+            friend class rope;
+            friend class iterator;
+        private:
+            const rope *rp;
+            Leaf *nod;
+            int idx;
+
+        public:
+            const_iterator(const rope *rp = NULL, Leaf *nod = NULL, int idx = 0) : rp(rp), nod(nod), idx(idx) {}
+
+            const_iterator(const const_iterator &rhs) : rp(rhs.rp), nod(rhs.nod), idx(rhs.idx) {}
+
+            const_iterator(const iterator &rhs) : rp(rhs.rp), nod(rhs.nod), idx(rhs.idx) {}
+
+            const_iterator operator+(const int &n) const {
+                long long pos = (long long)rp->index(*this) + n;
+                if (pos < 0 || pos > (long long)rp->size())
+                    throw index_out_of_bound();
+                return rp->citeratorAt(pos);
+            }
+
+            const_iterator operator-(const int &n) const {
+                return operator+(-n);
+            }
+
+            int operator-(const const_iterator &rhs) const {
+                if (rp != rhs.rp)
+                    throw invalid_iterator();
+                return (int)rp->index(*this) - (int)rp->index(rhs);
+            }
+
+            const_iterator operator+=(const int &n) {
+                *this = (*this) + n;
+                return *this;
+            }
+
+            const_iterator operator-=(const int &n) {
+                *this = (*this) - n;
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            const_iterator &operator++() {
+                if (nod == NULL)
+                    throw invalid_iterator();
+                if (++idx == (int)nod->cnt) {
+                    nod = nod->next;
+                    idx = 0;
+                }
+                return *this;
+            }
+
+            const_iterator operator--(int) {
+                const_iterator ret = *this;
+                --(*this);
+                return ret;
+            }
+
+            const_iterator &operator--() {
+                if (nod == NULL) {
+                    if (rp->empty())
+                        throw invalid_iterator();
+                    nod = rp->last;
+                    idx = nod->cnt - 1;
+                }
+                else if (idx == 0) {
+                    if (nod->prev == NULL)
+                        throw invalid_iterator();
+                    nod = nod->prev;
+                    idx = nod->cnt - 1;
+                }
+                else {
+                    idx--;
+                }
+                return *this;
+            }
+
+            const T &operator*() const {
+                if (nod == NULL)
+                    throw invalid_iterator();
+                return *(nod->data[idx]);
+            }
+
+            const T *operator->() const noexcept {
+                return nod->data[idx];
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return rp == rhs.rp && nod == rhs.nod && idx == rhs.idx;
+            }
+
+            bool operator==(const const_iterator &rhs) const {
+                return rp == rhs.rp && nod == rhs.nod && idx == rhs.idx;
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+        };
+
+    private:
+        size_t index(const const_iterator &it) const {
+            if (it.nod == NULL)
+                return size();
+            return indexOf(it.nod, it.idx);
+        }
+
+        iterator iteratorAt(size_t pos) {
+            if (pos == size())
+                return end();
+            Leaf *p = locate(pos);
+            return iterator(this, p, pos);
+        }
+
+        const_iterator citeratorAt(size_t pos) const {
+            if (pos == size())
+                return cend();
+            Leaf *p = locate(pos);
+            return const_iterator(this, p, pos);
+        }
+
+    public:
+        rope() {
+            first = last = new Leaf;
+            root = first;
+        }
+
+        rope(const rope &other) {
+            Leaf *tailLeaf = NULL;
+            root = copy(other.root, NULL, tailLeaf);
+            last = tailLeaf;
+        }
+
+        ~rope() {
+            makeEmpty(root);
+        }
+
+        rope &operator=(const rope &other) {
+            if (this == &other)
+                return *this;
+
+            makeEmpty(root);
+            Leaf *tailLeaf = NULL;
+            root = copy(other.root, NULL, tailLeaf);
+            last = tailLeaf;
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if out of bound.
+         */
+        T &at(const size_t &pos) {
+            if (pos >= size())
+                throw index_out_of_bound();
+            size_t n = pos;
+            Leaf *p = locate(n);
+            return *(p->data[n]);
+        }
+
+        const T &at(const size_t &pos) const {
+            if (pos >= size())
+                throw index_out_of_bound();
+            size_t n = pos;
+            Leaf *p = locate(n);
+            return *(p->data[n]);
+        }
+
+        T &operator[](const size_t &pos) {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty when the container is empty.
+         */
+        const T &front() const {
+            if (empty())
+                throw container_is_empty();
+            return *(first->data[0]);
+        }
+
+        const T &back() const {
+            if (empty())
+                throw container_is_empty();
+            return *(last->data[last->cnt - 1]);
+        }
+
+        iterator begin() {
+            if (empty())
+                return end();
+            return iterator(this, first, 0);
+        }
+
+        const_iterator cbegin() const {
+            if (empty())
+                return cend();
+            return const_iterator(this, first, 0);
+        }
+
+        iterator end() {
+            return iterator(this, NULL, 0);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(this, NULL, 0);
+        }
+
+        bool empty() const {
+            return root->cnt == 0;
+        }
+
+        size_t size() const {
+            return root->cnt;
+        }
+
+        void clear() {
+            makeEmpty(root);
+            first = last = new Leaf;
+            root = first;
+        }
+
+        /**
+         * inserts value so that it becomes the pos-th element.
+         * throw index_out_of_bound if pos > size().
+         */
+        iterator insert(size_t pos, const T &value) {
+            if (pos > size())
+                throw index_out_of_bound();
+
+            size_t n = pos;
+            Leaf *p = locate(n);
+            T *tmp = new T(value);
+            for (size_t i = p->cnt; i > n; --i)
+                p->data[i] = p->data[i - 1];
+            p->data[n] = tmp;
+            addCount(p, 1);
+
+            if (p->cnt > (size_t)leafSize) {
+                splitLeaf(p);
+                return iteratorAt(pos);
+            }
+            return iterator(this, p, n);
+        }
+
+        /**
+         * inserts value before pos.
+         * throw invalid_iterator if pos belongs to another container.
+         */
+        iterator insert(iterator pos, const T &value) {
+            if (pos.rp != this)
+                throw invalid_iterator();
+            return insert(index(pos), value);
+        }
+
+        /**
+         * removes the pos-th element, returns an iterator to the following one.
+         * throw index_out_of_bound if pos >= size().
+         */
+        iterator erase(size_t pos) {
+            if (pos >= size())
+                throw index_out_of_bound();
+
+            size_t n = pos;
+            Leaf *p = locate(n);
+            delete p->data[n];
+            for (size_t i = n + 1; i < p->cnt; ++i)
+                p->data[i - 1] = p->data[i];
+            addCount(p, -1);
+
+            if (p != root && p->cnt < (size_t)leafSize / 2) {
+                fixLeaf(p);
+                return iteratorAt(pos);
+            }
+            if (n == p->cnt)
+                return iterator(this, p->next, 0);
+            return iterator(this, p, n);
+        }
+
+        /**
+         * throw invalid_iterator if pos is end() or belongs to another container.
+         */
+        iterator erase(iterator pos) {
+            if (pos.rp != this || pos.nod == NULL)
+                throw invalid_iterator();
+            return erase(index(pos));
+        }
+
+        void push_back(const T &value) {
+            insert(size(), value);
+        }
+
+        void pop_back() {
+            if (empty())
+                throw container_is_empty();
+            erase(size() - 1);
+        }
+
+        void push_front(const T &value) {
+            insert((size_t)0, value);
+        }
+
+        void pop_front() {
+            if (empty())
+                throw container_is_empty();
+            erase((size_t)0);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef SJTU_SPILL_QUEUE_HPP
+#define SJTU_SPILL_QUEUE_HPP
+
+#include "exceptions.hpp"
+#include "deque.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace sjtu {
+    /**
+     * a FIFO queue which keeps only its two ends in memory.
+     * elements are grouped in blocks; the block being pushed to and the block being popped from
+     * always stay in memory, full blocks in between go through a bounded write-behind buffer
+     * to a file and are read back, several blocks at a time, when the consumer reaches them.
+     * so memory use is bounded by (2 + writeBehind + readAhead) blocks whatever the length.
+     * T must be trivially copyable since blocks are written to disk byte by byte.
+     */
+    template<class T>
+    class spill_queue {
+        static_assert(std::is_trivially_copyable<T>::value, "spill_queue needs a trivially copyable T");
+
+    private:
+        struct Block {
+            T *data;
+            size_t first, last;
+
+            Block(size_t cap) : first(0), last(0) {
+                data = static_cast<T *>(::operator new(cap * sizeof(T)));
+            }
+
+            ~Block() {
+                ::operator delete(data);
+            }
+
+            size_t size() const {
+                return last - first;
+            }
+        };
+
+        size_t blockElems, writeBehind, readAhead;
+        size_t tot;
+
+        /**
+         * oldest to newest: front, ahead, [disk], behind, back.
+         * front == back while everything fits in one block.
+         */
+        Block *front_, *back_;
+        deque<Block *> ahead, behind;
+
+        std::FILE *file;
+        long long readOff, writeOff;
+        size_t onDisk;
+        char *io;
+
+        Block *newBlock() {
+            return new Block(blockElems);
+        }
+
+        /**
+         * writes every block of the write-behind buffer to the end of the file, writeBehind blocks per call.
+         * blocks leave the buffer only once they are written, so after a failed write
+         * the buffer is intact and the next flush() writes it again at the same place.
+         */
+        void flush() {
+            size_t bytes = blockElems * sizeof(T);
+            while (!behind.empty()) {
+                size_t n = behind.size() < writeBehind ? behind.size() : writeBehind;
+                for (size_t i = 0; i < n; ++i)
+                    std::memcpy(io + i * bytes, behind[i]->data, bytes);
+                if (std::fseek(file, writeOff, SEEK_SET) != 0 || std::fwrite(io, bytes, n, file) != n ||
+                    std::fflush(file) != 0) {
+                    std::clearerr(file);
+                    throw runtime_error();
+                }
+
+                for (size_t i = 0; i < n; ++i) {
+                    delete behind.front();
+                    behind.pop_front();
+                }
+                writeOff += (long long)(n * bytes);
+                onDisk += n;
+            }
+        }
+
+        /**
+         * reads up to readAhead blocks from the head of the file.
+         * the file is rewound once it has been consumed, so it only grows with the backlog.
+         */
+        void fill() {
+            size_t n = onDisk < readAhead ? onDisk : readAhead;
+            size_t bytes = blockElems * sizeof(T);
+            if (std::fflush(file) != 0 || std::fseek(file, readOff, SEEK_SET) != 0 ||
+                std::fread(io, bytes, n, file) != n)
+                throw runtime_error();
+
+            size_t i = 0;
+            try {
+                for (; i < n; ++i) {
+                    Block *b = newBlock();
+                    std::memcpy(b->data, io + i * bytes, bytes);
+                    b->last = blockElems;
+                    try {
+                        ahead.push_back(b);
+                    }
+                    catch (...) {
+                        delete b;
+                        throw;
+                    }
+                }
+            }
+            catch (...) {
+                for (; i > 0; --i) {
+                    delete ahead.back();
+                    ahead.pop_back();
+                }
+                throw;
+            }
+            readOff += (long long)(n * bytes);
+            onDisk -= n;
+            if (onDisk == 0)
+                readOff = writeOff = 0;
+        }
+
+        /**
+         * called when the front block is used up: takes the next block in queue order.
+         * if reading the file fails nothing has changed.
+         */
+        void advance() {
+            if (ahead.empty() && onDisk > 0)
+                fill();
+
+            Block *next;
+            if (!ahead.empty()) {
+                next = ahead.front();
+                ahead.pop_front();
+            }
+            else if (!behind.empty()) {
+                next = behind.front();
+                behind.pop_front();
+            }
+            else
+                next = back_;
+            delete front_;
+            front_ = next;
+        }
+
+    public:
+        /**
+         * blockElems elements per block, at most writeBehind full blocks wait in memory before
+         * being written and at most readAhead blocks are read back at once.
+         * path names the spill file; by default an anonymous temporary file is used.
+         * throw runtime_error if a parameter is 0 or the file cannot be opened.
+         */
+        explicit spill_queue(size_t blockElems = 4096, size_t writeBehind = 16, size_t readAhead = 16,
+                             const char *path = NULL)
+            : blockElems(blockElems), writeBehind(writeBehind), readAhead(readAhead), tot(0),
+              readOff(0), writeOff(0), onDisk(0) {
+            if (blockElems == 0 || writeBehind == 0 || readAhead == 0)
+                throw runtime_error();
+
+            file = path ? std::fopen(path, "w+b") : std::tmpfile();
+            if (file == NULL)
+                throw runtime_error();
+
+            size_t n = writeBehind > readAhead ? writeBehind : readAhead;
+            io = new char[n * blockElems * sizeof(T)];
+            front_ = back_ = newBlock();
+        }
+
+        spill_queue(const spill_queue &) = delete;
+
+        spill_queue &operator=(const spill_queue &) = delete;
+
+        ~spill_queue() {
+            while (!ahead.empty()) {
+                delete ahead.front();
+                ahead.pop_front();
+            }
+            while (!behind.empty()) {
+                delete behind.front();
+                behind.pop_front();
+            }
+            if (back_ != front_)
+                delete back_;
+            delete front_;
+            delete [] io;
+            std::fclose(file);
+        }
+
+        /**
+         * adds an element to the end.
+         * throw runtime_error if the spill file cannot be written; then value is not added,
+         * the unwritten blocks stay in memory and are written by a later push().
+         */
+        void push(const T &value) {
+            if (back_->last == blockElems) {
+                Block *b = newBlock();
+                if (back_ != front_) {
+                    try {
+                        behind.push_back(back_);
+                    }
+                    catch (...) {
+                        delete b;
+                        throw;
+                    }
+                }
+                back_ = b;
+                // the queue is whole again, a failed write keeps the blocks for the next flush()
+                if (behind.size() >= writeBehind)
+                    flush();
+            }
+            back_->data[back_->last++] = value;
+            tot++;
+        }
+
+        /**
+         * removes the first element.
+         * throw container_is_empty when the container is empty,
+         * runtime_error if the spill file cannot be read, then the queue is left as it was.
+         */
+        void pop() {
+            if (empty())
+                throw container_is_empty();
+
+            if (front_->first + 1 < front_->last)
+                front_->first++;
+            else if (front_ == back_)
+                front_->first = front_->last = 0;
+            else
+                advance();
+            tot--;
+        }
+
+        /**
+         * throw container_is_empty when the container is empty.
+         */
+        const T &front() const {
+            if (empty())
+                throw container_is_empty();
+            return front_->data[front_->first];
+        }
+
+        const T &back() const {
+            if (empty())
+                throw container_is_empty();
+            return back_->data[back_->last - 1];
+        }
+
+        bool empty() const {
+            return tot == 0;
+        }
+
+        size_t size() const {
+            return tot;
+        }
+
+        /**
+         * number of elements currently in the spill file.
+         */
+        size_t spilled() const {
+            return onDisk * blockElems;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef SJTU_WINDOW_AGGREGATOR_HPP
+#define SJTU_WINDOW_AGGREGATOR_HPP
+
+#include "exceptions.hpp"
+#include "utility.hpp"
+#include "deque.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace sjtu {
+    template<class T>
+    struct min_of {
+        T operator()(const T &a, const T &b) const {
+            return b < a ? b : a;
+        }
+    };
+
+    template<class T>
+    struct max_of {
+        T operator()(const T &a, const T &b) const {
+            return a < b ? b : a;
+        }
+    };
+
+    template<class T>
+    struct gcd_of {
+        T operator()(T a, T b) const {
+            if (a < 0)
+                a = -a;
+            if (b < 0)
+                b = -b;
+            while (b != 0) {
+                T t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+    };
+
+    /**
+     * a FIFO window which answers op(x1, op(x2, ... xn)) over its contents in O(1).
+     * op must be associative, it need not be commutative nor have an identity.
+     * two stacks are kept: the back one holds each element with the aggregate of the back stack up to it,
+     * the front one holds each element with the aggregate from it to the end of the front stack.
+     * both stacks grow at the back of their deque, so the oldest element is out.back().
+     * when the front stack runs out, the back stack is folded into it in one pass,
+     * so push_back(), pop_front() and query() are O(1) amortized.
+     */
+    template<class T, class Op = std::plus<T> >
+    class window_aggregator {
+    private:
+        typedef pair<T, T> entry;
+
+        Op op;
+        deque<entry> in, out;
+
+        /**
+         * moves the back stack to the (empty) front stack, computing suffix aggregates from the newest element.
+         * the new stack is built at the back of a fresh deque in one pass and swapped in,
+         * so no element is shifted and a throwing op leaves both stacks as they were.
+         */
+        void flip() {
+            if (in.empty())
+                return;
+
+            deque<entry> next;
+            typename deque<entry>::iterator it = in.end();
+            --it;
+            T acc = it->first;
+            next.push_back(entry(acc, acc));
+            while (it != in.begin()) {
+                --it;
+                acc = op(it->first, acc);
+                next.push_back(entry(it->first, acc));
+            }
+            out.swap(next);
+            in.clear();
+        }
+
+    public:
+        explicit window_aggregator(const Op &op = Op()) : op(op) {}
+
+        /**
+         * adds value as the newest element.
+         */
+        void push_back(const T &value) {
+            if (in.empty())
+                in.push_back(entry(value, value));
+            else
+                in.push_back(entry(value, op(in.back().second, value)));
+        }
+
+        /**
+         * removes the oldest element.
+         * throw container_is_empty when the window is empty.
+         */
+        void pop_front() {
+            if (empty())
+                throw container_is_empty();
+            if (out.empty())
+                flip();
+            out.pop_back();
+        }
+
+        /**
+         * the aggregate of every element, oldest first.
+         * throw container_is_empty when the window is empty.
+         */
+        T query() const {
+            if (empty())
+                throw container_is_empty();
+            if (out.empty())
+                return in.back().second;
+            if (in.empty())
+                return out.back().second;
+            return op(out.back().second, in.back().second);
+        }
+
+        /**
+         * the oldest and the newest element.
+         * throw container_is_empty when the window is empty.
+         */
+        const T &front() const {
+            if (empty())
+                throw container_is_empty();
+            return out.empty() ? in.front().first : out.back().first;
+        }
+
+        const T &back() const {
+            if (empty())
+                throw container_is_empty();
+            return in.empty() ? out.front().first : in.back().first;
+        }
+
+        size_t size() const {
+            return in.size() + out.size();
+        }
+
+        bool empty() const {
+            return in.empty() && out.empty();
+        }
+
+        void clear() {
+            in.clear();
+            out.clear();
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef SJTU_WS_DEQUE_HPP
+#define SJTU_WS_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sjtu {
+    /**
+     * a lock-free work-stealing deque (Chase-Lev, with the C11 orderings of Le et al. 2013).
+     * only the owner thread may push() and pop() at the bottom,
+     * any other thread may steal() from the top.
+     * elements live in a circular array which grows when it is full;
+     * old arrays are kept until destruction since a thief may still be reading them.
+     * T must be trivially copyable, usually it is a pointer to a task.
+     */
+    template<class T>
+    class ws_deque {
+        static_assert(std::is_trivially_copyable<T>::value, "ws_deque needs a trivially copyable T");
+
+    private:
+        struct Array {
+            long long cap;
+            std::atomic<T> *buf;
+
+            Array(long long cap) : cap(cap) {
+                buf = new std::atomic<T>[cap];
+            }
+
+            ~Array() {
+                delete [] buf;
+            }
+
+            T get(long long i) const {
+                return buf[i & (cap - 1)].load(std::memory_order_relaxed);
+            }
+
+            void put(long long i, const T &x) {
+                buf[i & (cap - 1)].store(x, std::memory_order_relaxed);
+            }
+
+            Array *grow(long long b, long long t) const {
+                Array *a = new Array(cap * 2);
+                for (long long i = t; i < b; ++i)
+                    a->put(i, get(i));
+                return a;
+            }
+        };
+
+        std::atomic<long long> top, bottom;
+        std::atomic<Array *> array;
+        std::vector<Array *> garbage;
+
+    public:
+        /**
+         * cap is rounded up to a power of two.
+         */
+        explicit ws_deque(long long cap = 64) : top(0), bottom(0) {
+            long long n = 1;
+            while (n < cap)
+                n <<= 1;
+            array.store(new Array(n), std::memory_order_relaxed);
+        }
+
+        ws_deque(const ws_deque &) = delete;
+
+        ws_deque &operator=(const ws_deque &) = delete;
+
+        ~ws_deque() {
+            delete array.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < garbage.size(); ++i)
+                delete garbage[i];
+        }
+
+        /**
+         * owner only: adds x at the bottom.
+         */
+        void push(const T &x) {
+            long long b = bottom.load(std::memory_order_relaxed);
+            long long t = top.load(std::memory_order_acquire);
+            Array *a = array.load(std::memory_order_relaxed);
+            if (b - t > a->cap - 1) {
+                garbage.push_back(a);
+                a = a->grow(b, t);
+                array.store(a, std::memory_order_release);
+            }
+            a->put(b, x);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * owner only: takes the element at the bottom.
+         * returns false if the deque was empty (or the last element was stolen meanwhile).
+         */
+        bool pop(T &x) {
+            long long b = bottom.load(std::memory_order_relaxed) - 1;
+            Array *a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            long long t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            x = a->get(b);
+            if (t == b) {
+                bool ok = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return ok;
+            }
+            return true;
+        }
+
+        /**
+         * any thread: takes the element at the top.
+         * returns false if the deque was empty or another thread won the race for it.
+         */
+        bool steal(T &x) {
+            long long t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            long long b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            Array *a = array.load(std::memory_order_acquire);
+            T tmp = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed))
+                return false;
+            x = tmp;
+            return true;
+        }
+
+        /**
+         * only a snapshot when other threads are stealing.
+         */
+        size_t size() const {
+            long long b = bottom.load(std::memory_order_relaxed);
+            long long t = top.load(std::memory_order_relaxed);
+            return b > t ? b - t : 0;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * btree_map against sjtu::map and std::map with int keys:
+ * random inserts, random finds, a full in-order scan and short range scans from lower_bound.
+ * build with: g++ -std=c++14 -O2 -I.. btree_bench.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include "../btree_map.hpp"
+#include "../map.hpp"
+
+const int N = 4000000;
+const int RANGES = 200000;
+const int RANGE_LEN = 100;
+
+template<class F>
+double time(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+}
+
+template<class M>
+void run(const char *name, const std::vector<int> &keys, const std::vector<int> &probe) {
+    M m;
+    long long sum = 0;
+    double ins = time([&]() {
+        for (int i = 0; i < N; ++i)
+            m[keys[i]] = i;
+    });
+    double fnd = time([&]() {
+        for (int i = 0; i < N; ++i)
+            sum += m.find(probe[i])->second;
+    });
+    double scan = time([&]() {
+        for (typename M::iterator it = m.begin(); it != m.end(); ++it)
+            sum += it->second;
+    });
+    double range = time([&]() {
+        for (int i = 0; i < RANGES; ++i) {
+            typename M::iterator it = m.lower_bound(probe[i]);
+            for (int k = 0; k < RANGE_LEN && it != m.end(); ++k, ++it)
+                sum += it->first;
+        }
+    });
+    printf("%-10s insert %8.1f ms  find %8.1f ms  scan %7.1f ms  ranges %7.1f ms  (checksum %lld)\n",
+           name, ins, fnd, scan, range, sum);
+}
+
+int main() {
+    srand(2017);
+    std::vector<int> keys(N), probe(N);
+    for (int i = 0; i < N; ++i)
+        keys[i] = i;
+    for (int i = N - 1; i > 0; --i) {
+        int j = rand() % (i + 1);
+        int t = keys[i];
+        keys[i] = keys[j];
+        keys[j] = t;
+    }
+    for (int i = 0; i < N; ++i)
+        probe[i] = rand() % N;
+
+    run<sjtu::btree_map<int, int> >("btree_map", keys, probe);
+    run<sjtu::map<int, int> >("sjtu::map", keys, probe);
+    run<std::map<int, int> >("std::map", keys, probe);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * building a sjtu::map from sorted keys, one insert at a time, with insert(end(), value)
+ * and with the sorted_unique constructor; then set operations between two random maps,
+ * done with the linear set_union/set_intersection/set_difference and key by key.
+ * build with: g++ -std=c++14 -O2 -I.. bulk_bench.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../map.hpp"
+
+const int N = 10000000;
+const int M = 2000000;
+
+typedef sjtu::map<int, int> imap;
+
+template<class F>
+double time(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+}
+
+int main() {
+    std::vector<imap::value_type> sorted;
+    sorted.reserve(N);
+    for (int i = 0; i < N; ++i)
+        sorted.push_back(imap::value_type(i, i));
+
+    long long sum = 0;
+    double ins = time([&]() {
+        imap m;
+        for (int i = 0; i < N; ++i)
+            m.insert(sorted[i]);
+        sum += m.size();
+    });
+    double hint = time([&]() {
+        imap m;
+        for (int i = 0; i < N; ++i)
+            m.insert(m.end(), sorted[i]);
+        sum += m.size();
+    });
+    double bulk = time([&]() {
+        imap m(sjtu::sorted_unique, sorted.begin(), sorted.end());
+        sum += m.size();
+    });
+    printf("%d sorted keys: insert %8.1f ms  hint %8.1f ms  sorted_unique %8.1f ms\n", N, ins, hint, bulk);
+
+    srand(2017);
+    imap a, b;
+    for (int i = 0; i < M; ++i) {
+        a[rand() % (2 * M)] = i;
+        b[rand() % (2 * M)] = i;
+    }
+    double lin[3], one[3];
+    for (int op = 0; op < 3; ++op) {
+        lin[op] = time([&]() {
+            imap c(a);
+            if (op == 0)
+                c.set_union(b);
+            else if (op == 1)
+                c.set_intersection(b);
+            else
+                c.set_difference(b);
+            sum += c.size();
+        });
+        one[op] = time([&]() {
+            imap c(a);
+            for (imap::const_iterator it = b.cbegin(); it != b.cend(); ++it) {
+                if (op == 0)
+                    c.insert(*it);
+                else if (op == 2)
+                    c.erase(it->first);
+            }
+            if (op == 1) {
+                for (imap::iterator it = c.begin(); it != c.end(); )
+                    it = b.count(it->first) ? ++it : c.erase(it);
+            }
+            sum += c.size();
+        });
+        // both columns include copying a
+    }
+    printf("%zu and %zu keys:  union %7.1f ms (key by key %7.1f)  intersection %7.1f ms (%7.1f)  difference %7.1f ms (%7.1f)\n",
+           a.size(), b.size(), lin[0], one[0], lin[1], one[1], lin[2], one[2]);
+    printf("(checksum %lld)\n", sum);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * sjtu::map against std::map on sorted, reverse-sorted and random key streams:
+ * insert every key, find every key, walk the map forwards and backwards,
+ * then erase every key in the same order. "hint" builds a second map with insert(end(), value),
+ * which only helps when the keys come in increasing order.
+ * build with: g++ -std=c++14 -O2 -I.. map_bench.cpp
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include "../map.hpp"
+
+const int N = 1000000;
+
+template<class F>
+double time(F f) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3;
+}
+
+template<class M>
+void run(const char *name, const std::vector<int> &keys) {
+    M m;
+    long long sum = 0;
+    double ins = time([&]() {
+        for (size_t i = 0; i < keys.size(); ++i)
+            m[keys[i]] = (int)i;
+    });
+    double hint = time([&]() {
+        M h;
+        for (size_t i = 0; i < keys.size(); ++i)
+            h.insert(h.end(), typename M::value_type(keys[i], (int)i));
+        sum += h.size();
+    });
+    double fnd = time([&]() {
+        for (size_t i = 0; i < keys.size(); ++i)
+            sum += m.find(keys[i])->second;
+    });
+    double walk = time([&]() {
+        for (typename M::iterator it = m.begin(); it != m.end(); ++it)
+            sum += it->first;
+        typename M::iterator it = m.end();
+        while (it != m.begin()) {
+            --it;
+            sum -= it->first;
+        }
+    });
+    double era = time([&]() {
+        for (size_t i = 0; i < keys.size(); ++i)
+            m.erase(m.find(keys[i]));
+    });
+    printf("%-10s insert %8.1f ms  hint %8.1f ms  find %8.1f ms  walk %7.1f ms  erase %8.1f ms  (checksum %lld)\n",
+           name, ins, hint, fnd, walk, era, sum);
+}
+
+void stream(const char *name, const std::vector<int> &keys) {
+    printf("%s:\n", name);
+    run<sjtu::map<int, int> >("sjtu::map", keys);
+    run<std::map<int, int> >("std::map", keys);
+}
+
+int main() {
+    std::vector<int> keys(N);
+    for (int i = 0; i < N; ++i)
+        keys[i] = i;
+    stream("sorted", keys);
+
+    for (int i = 0; i < N; ++i)
+        keys[i] = N - i;
+    stream("reverse", keys);
+
+    srand(2017);
+    for (int i = N - 1; i > 0; --i) {
+        int j = rand() % (i + 1);
+        int t = keys[i];
+        keys[i] = keys[j];
+        keys[j] = t;
+    }
+    stream("random", keys);
+    return 0;
+}
@@ -0,0 +1,1097 @@
+/**
+ * an ordered map kept in a B+ tree
+ */
+#ifndef SJTU_BTREE_MAP_HPP
+#define SJTU_BTREE_MAP_HPP
+
+#include <functional>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "utility.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+/**
+ * a B+ tree with the interface of map.
+ * every node holds its keys in one contiguous array a few cache lines long, so a lookup
+ * touches about log_64(n) nodes instead of log_2(n); the elements live only in the leaves,
+ * which are linked in order, so a scan is a walk along arrays.
+ * each leaf keeps a copy of its keys next to the pairs handed out by the iterators.
+ *
+ * unlike map, insert and erase move elements inside and between nodes:
+ * they invalidate every iterator of the btree_map (erase returns a valid one).
+ *
+ * insert leaves the map untouched if allocating a node or building the new element throws,
+ * and every new separator key is copied before a node is changed.
+ * but moving an element copies its key, which is const in the pair, and that happens
+ * while nodes are being shifted: a Key whose copy constructor throws then may leave the map broken.
+ * Key's move constructor must not throw.
+ */
+template<
+	class Key,
+	class T,
+	class Compare = std::less<Key>
+> class btree_map {
+public:
+	typedef pair<const Key, T> value_type;
+
+private:
+    /**
+     * the keys of a node take about keyBytes, the values of a leaf about valueBytes,
+     * but a node always has room for at least 8 entries.
+     */
+    static const int keyBytes = 256;
+    static const int valueBytes = 1024;
+    static const int byKey = keyBytes / (int)sizeof(Key);
+    static const int byValue = valueBytes / (int)sizeof(value_type);
+    static const int byBoth = byKey < byValue ? byKey : byValue;
+    static const int leafCap = byBoth > 8 ? byBoth : 8;
+    static const int innerCap = byKey > 8 ? byKey : 8;
+    static const int minLeaf = leafCap / 2;
+    static const int minInner = innerCap / 2;
+
+    typedef typename std::aligned_storage<sizeof(Key), alignof(Key)>::type keySlot;
+    typedef typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type valueSlot;
+
+    struct Inner;
+
+    /**
+     * n is the number of elements of a leaf, or the number of children of an inner node.
+     */
+    struct Node {
+        bool leaf;
+        int n;
+        Inner *father;
+
+        Node(bool leaf) : leaf(leaf), n(0), father(NULL) {}
+    };
+
+    struct Leaf : Node {
+        Leaf *prev, *next;
+        keySlot keys[leafCap];
+        valueSlot vals[leafCap];
+
+        Leaf() : Node(true), prev(NULL), next(NULL) {}
+
+        Key &key(int i) {
+            return *reinterpret_cast<Key *>(keys + i);
+        }
+        value_type &val(int i) {
+            return *reinterpret_cast<value_type *>(vals + i);
+        }
+    };
+
+    /**
+     * child[i] holds the keys k with key(i - 1) <= k < key(i).
+     */
+    struct Inner : Node {
+        keySlot keys[innerCap - 1];
+        Node *child[innerCap];
+
+        Inner() : Node(false) {}
+
+        Key &key(int i) {
+            return *reinterpret_cast<Key *>(keys + i);
+        }
+    };
+
+    /**
+     * an element built outside the tree, so that building it cannot leave a node half changed.
+     */
+    struct Entry {
+        keySlot k;
+        valueSlot v;
+
+        Entry(const value_type &x) {
+            new (&v) value_type(x);
+            build();
+        }
+        template<class K, class M>
+        Entry(K &&key, M &&m) {
+            new (&v) value_type(std::forward<K>(key), std::forward<M>(m));
+            build();
+        }
+        ~Entry() {
+            value().~value_type();
+            reinterpret_cast<Key *>(&k)->~Key();
+        }
+
+        void build() {
+            try {
+                new (&k) Key(value().first);
+            }
+            catch (...) {
+                value().~value_type();
+                throw;
+            }
+        }
+        Key &key() {
+            return *reinterpret_cast<Key *>(&k);
+        }
+        value_type &value() {
+            return *reinterpret_cast<value_type *>(&v);
+        }
+    };
+
+    Compare cmp;
+    Node *root;
+    Leaf *head, *tail;
+    size_t _size;
+
+    static void moveKey(keySlot *dst, Key &src) {
+        new (dst) Key(std::move(src));
+        src.~Key();
+    }
+
+    /**
+     * replaces the key in slot by k, which is moved from; the caller copies k beforehand,
+     * so that nothing is destroyed before the copy has succeeded.
+     */
+    static void setKey(Key &slot, Key &k) {
+        slot.~Key();
+        moveKey(reinterpret_cast<keySlot *>(&slot), k);
+    }
+
+    /**
+     * moves element i of src into the empty slot j of dst.
+     * the pair is built first: its key is const, so this copies the key, and if that throws
+     * neither slot has changed. a caller in the middle of shifting a node is not protected,
+     * see the class comment.
+     */
+    static void moveEntry(Leaf *dst, int j, Leaf *src, int i) {
+        new (dst->vals + j) value_type(std::move(src->val(i)));
+        src->val(i).~value_type();
+        moveKey(dst->keys + j, src->key(i));
+    }
+
+    /**
+     * the first i with key(i) >= k, and the first i with key(i) > k.
+     */
+    int lower(Leaf *l, const Key &k) const {
+        int lo = 0, hi = l->n;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cmp(l->key(mid), k))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    int upper(Leaf *l, const Key &k) const {
+        int lo = 0, hi = l->n;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cmp(k, l->key(mid)))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    /**
+     * the child of t whose range holds k.
+     */
+    int route(Inner *t, const Key &k) const {
+        int lo = 0, hi = t->n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cmp(k, t->key(mid)))
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        return lo;
+    }
+
+    Leaf *leafOf(const Key &k) const {
+        Node *t = root;
+        if (t == NULL)
+            return NULL;
+        while (!t->leaf)
+            t = static_cast<Inner *>(t)->child[route(static_cast<Inner *>(t), k)];
+        return static_cast<Leaf *>(t);
+    }
+
+    /**
+     * true if k is present; either way l and i are where it is or would be.
+     */
+    bool locate(const Key &k, Leaf *&l, int &i) const {
+        l = leafOf(k);
+        if (l == NULL) {
+            i = 0;
+            return false;
+        }
+        i = lower(l, k);
+        return i < l->n && !cmp(k, l->key(i));
+    }
+
+    static int indexOf(Inner *p, Node *c) {
+        int i = 0;
+        while (p->child[i] != c)
+            ++i;
+        return i;
+    }
+
+    /**
+     * puts e at i in l, which has room.
+     */
+    static void put(Leaf *l, int i, Entry &e) {
+        for (int j = l->n; j > i; --j)
+            moveEntry(l, j, l, j - 1);
+        new (l->keys + i) Key(std::move(e.key()));
+        new (l->vals + i) value_type(std::move(e.value()));
+        l->n++;
+    }
+
+    /**
+     * inserts e at position i of leaf l (l == NULL when the tree is empty), splitting full nodes
+     * on the way up. new nodes and the separator are made before the tree is touched.
+     */
+    pair<Leaf *, int> insertAt(Leaf *l, int i, Entry &e) {
+        if (root == NULL) {
+            l = new Leaf;
+            root = head = tail = l;
+        }
+        if (l->n < leafCap) {
+            put(l, i, e);
+            ++_size;
+            return pair<Leaf *, int>(l, i);
+        }
+
+        // appending to the last leaf leaves it full, so sorted loads fill every leaf
+        bool edge = l == tail && i == l->n;
+        int m = edge ? leafCap : leafCap / 2;
+        bool right = i > m || (i == m && edge);
+
+        Inner *spare[64];
+        int nspare = 0;
+        Leaf *r = NULL;
+        keySlot sep;
+        try {
+            r = new Leaf;
+            for (Inner *p = l->father; p == NULL || p->n == innerCap; p = p->father) {
+                spare[nspare++] = new Inner;
+                if (p == NULL)
+                    break;
+            }
+            new (&sep) Key(right && i == m ? e.key() : l->key(m));
+        }
+        catch (...) {
+            while (nspare > 0)
+                delete spare[--nspare];
+            delete r;
+            throw;
+        }
+
+        for (int j = m; j < l->n; ++j)
+            moveEntry(r, j - m, l, j);
+        r->n = l->n - m;
+        l->n = m;
+        r->prev = l;
+        r->next = l->next;
+        if (l->next != NULL)
+            l->next->prev = r;
+        else
+            tail = r;
+        l->next = r;
+
+        Leaf *t = right ? r : l;
+        int ti = right ? i - m : i;
+        put(t, ti, e);
+        ++_size;
+
+        insertUp(l, sep, r, spare, nspare);
+        while (nspare > 0)
+            delete spare[--nspare];
+        return pair<Leaf *, int>(t, ti);
+    }
+
+    /**
+     * hangs r just after its left half l in their father, with the separator sep (moved from),
+     * splitting full inner nodes in halves; new nodes are taken from spare.
+     */
+    void insertUp(Node *l, keySlot &sep, Node *r, Inner **spare, int &nspare) {
+        while (true) {
+            Inner *p = l->father;
+            if (p == NULL) {
+                p = spare[--nspare];
+                p->child[0] = l;
+                p->child[1] = r;
+                moveKey(p->keys, *reinterpret_cast<Key *>(&sep));
+                p->n = 2;
+                l->father = r->father = p;
+                root = p;
+                return;
+            }
+
+            int i = indexOf(p, l);
+            if (p->n < innerCap) {
+                for (int j = p->n - 1; j > i; --j)
+                    p->child[j + 1] = p->child[j];
+                for (int j = p->n - 2; j >= i; --j)
+                    moveKey(p->keys + j + 1, p->key(j));
+                moveKey(p->keys + i, *reinterpret_cast<Key *>(&sep));
+                p->child[i + 1] = r;
+                r->father = p;
+                p->n++;
+                return;
+            }
+
+            // p is full: lay out the innerCap + 1 children in order, then deal them out
+            Node *ch[innerCap + 1];
+            keySlot ks[innerCap];
+            for (int j = 0; j < innerCap; ++j)
+                ch[j < i + 1 ? j : j + 1] = p->child[j];
+            ch[i + 1] = r;
+            for (int j = 0; j < innerCap - 1; ++j)
+                moveKey(ks + (j < i ? j : j + 1), p->key(j));
+            moveKey(ks + i, *reinterpret_cast<Key *>(&sep));
+
+            int m = (innerCap + 1) / 2;
+            Inner *q = spare[--nspare];
+            for (int j = 0; j < m; ++j) {
+                p->child[j] = ch[j];
+                ch[j]->father = p;
+            }
+            for (int j = 0; j < m - 1; ++j)
+                moveKey(p->keys + j, *reinterpret_cast<Key *>(ks + j));
+            p->n = m;
+            moveKey(&sep, *reinterpret_cast<Key *>(ks + m - 1));
+            for (int j = m; j <= innerCap; ++j) {
+                q->child[j - m] = ch[j];
+                ch[j]->father = q;
+            }
+            for (int j = m; j < innerCap; ++j)
+                moveKey(q->keys + j - m, *reinterpret_cast<Key *>(ks + j));
+            q->n = innerCap + 1 - m;
+
+            l = p;
+            r = q;
+        }
+    }
+
+    /**
+     * drops child j of p together with the key before it (key 0 for j == 0),
+     * whose slot the caller has already emptied.
+     */
+    static void removeChild(Inner *p, int j) {
+        int kj = j > 0 ? j - 1 : 0;
+        for (int k = kj + 1; k < p->n - 1; ++k)
+            moveKey(p->keys + k - 1, p->key(k));
+        for (int c = j + 1; c < p->n; ++c)
+            p->child[c - 1] = p->child[c];
+        p->n--;
+    }
+
+    void unlinkLeaf(Leaf *l) {
+        if (l->prev != NULL)
+            l->prev->next = l->next;
+        else
+            head = l->next;
+        if (l->next != NULL)
+            l->next->prev = l->prev;
+        else
+            tail = l->prev;
+    }
+
+    /**
+     * removes element i of l and refills l from a sibling if it got too small.
+     * returns where the element after it is now.
+     */
+    pair<Leaf *, int> eraseAt(Leaf *l, int i) {
+        l->val(i).~value_type();
+        l->key(i).~Key();
+        for (int j = i + 1; j < l->n; ++j)
+            moveEntry(l, j - 1, l, j);
+        l->n--;
+        --_size;
+
+        if (l == root) {
+            if (l->n == 0) {
+                delete l;
+                root = head = tail = NULL;
+                return pair<Leaf *, int>((Leaf *)NULL, 0);
+            }
+            return pair<Leaf *, int>(l, i);
+        }
+        if (l->n >= minLeaf)
+            return pair<Leaf *, int>(l, i);
+
+        Inner *p = l->father;
+        int j = indexOf(p, l);
+        Leaf *ls = j > 0 ? static_cast<Leaf *>(p->child[j - 1]) : NULL;
+        Leaf *rs = j + 1 < p->n ? static_cast<Leaf *>(p->child[j + 1]) : NULL;
+        if (ls != NULL && ls->n > minLeaf) {
+            keySlot sep;
+            new (&sep) Key(ls->key(ls->n - 1));
+            for (int k = l->n; k > 0; --k)
+                moveEntry(l, k, l, k - 1);
+            moveEntry(l, 0, ls, ls->n - 1);
+            ls->n--;
+            l->n++;
+            i++;
+            setKey(p->key(j - 1), *reinterpret_cast<Key *>(&sep));
+            return pair<Leaf *, int>(l, i);
+        }
+        if (rs != NULL && rs->n > minLeaf) {
+            keySlot sep;
+            new (&sep) Key(rs->key(1));
+            moveEntry(l, l->n, rs, 0);
+            l->n++;
+            for (int k = 1; k < rs->n; ++k)
+                moveEntry(rs, k - 1, rs, k);
+            rs->n--;
+            setKey(p->key(j), *reinterpret_cast<Key *>(&sep));
+            return pair<Leaf *, int>(l, i);
+        }
+
+        if (ls != NULL) {
+            for (int k = 0; k < l->n; ++k)
+                moveEntry(ls, ls->n + k, l, k);
+            i += ls->n;
+            ls->n += l->n;
+            unlinkLeaf(l);
+            delete l;
+            l = ls;
+            p->key(j - 1).~Key();
+            removeChild(p, j);
+        }
+        else {
+            for (int k = 0; k < rs->n; ++k)
+                moveEntry(l, l->n + k, rs, k);
+            l->n += rs->n;
+            unlinkLeaf(rs);
+            delete rs;
+            p->key(j).~Key();
+            removeChild(p, j + 1);
+        }
+        fixInner(p);
+        return pair<Leaf *, int>(l, i);
+    }
+
+    /**
+     * refills inner nodes which lost a child, from p up to the root,
+     * then drops roots left with a single child.
+     */
+    void fixInner(Inner *p) {
+        while (p != root && p->n < minInner) {
+            Inner *g = p->father;
+            int j = indexOf(g, p);
+            Inner *ls = j > 0 ? static_cast<Inner *>(g->child[j - 1]) : NULL;
+            Inner *rs = j + 1 < g->n ? static_cast<Inner *>(g->child[j + 1]) : NULL;
+            if (ls != NULL && ls->n > minInner) {
+                for (int k = p->n - 1; k >= 0; --k)
+                    p->child[k + 1] = p->child[k];
+                for (int k = p->n - 2; k >= 0; --k)
+                    moveKey(p->keys + k + 1, p->key(k));
+                moveKey(p->keys, g->key(j - 1));
+                p->child[0] = ls->child[ls->n - 1];
+                p->child[0]->father = p;
+                p->n++;
+                moveKey(g->keys + j - 1, ls->key(ls->n - 2));
+                ls->n--;
+                break;
+            }
+            if (rs != NULL && rs->n > minInner) {
+                moveKey(p->keys + p->n - 1, g->key(j));
+                p->child[p->n] = rs->child[0];
+                p->child[p->n]->father = p;
+                p->n++;
+                moveKey(g->keys + j, rs->key(0));
+                for (int k = 1; k < rs->n - 1; ++k)
+                    moveKey(rs->keys + k - 1, rs->key(k));
+                for (int k = 1; k < rs->n; ++k)
+                    rs->child[k - 1] = rs->child[k];
+                rs->n--;
+                break;
+            }
+
+            if (ls != NULL) {
+                moveKey(ls->keys + ls->n - 1, g->key(j - 1));
+                for (int k = 0; k < p->n - 1; ++k)
+                    moveKey(ls->keys + ls->n + k, p->key(k));
+                for (int k = 0; k < p->n; ++k) {
+                    ls->child[ls->n + k] = p->child[k];
+                    p->child[k]->father = ls;
+                }
+                ls->n += p->n;
+                delete p;
+                removeChild(g, j);
+            }
+            else {
+                moveKey(p->keys + p->n - 1, g->key(j));
+                for (int k = 0; k < rs->n - 1; ++k)
+                    moveKey(p->keys + p->n + k, rs->key(k));
+                for (int k = 0; k < rs->n; ++k) {
+                    p->child[p->n + k] = rs->child[k];
+                    rs->child[k]->father = p;
+                }
+                p->n += rs->n;
+                delete rs;
+                removeChild(g, j + 1);
+            }
+            p = g;
+        }
+
+        while (!root->leaf && root->n == 1) {
+            Inner *old = static_cast<Inner *>(root);
+            root = old->child[0];
+            root->father = NULL;
+            delete old;
+        }
+    }
+
+    /**
+     * frees every node, children before their father, consuming the child counts on the way.
+     */
+    void makeEmpty() {
+        Node *t = root;
+        while (t != NULL) {
+            if (!t->leaf && t->n > 0) {
+                Inner *p = static_cast<Inner *>(t);
+                p->n--;
+                if (p->n > 0)
+                    p->key(p->n - 1).~Key();
+                t = p->child[p->n];
+                continue;
+            }
+
+            Inner *fa = t->father;
+            if (t->leaf) {
+                Leaf *l = static_cast<Leaf *>(t);
+                for (int i = 0; i < l->n; ++i) {
+                    l->val(i).~value_type();
+                    l->key(i).~Key();
+                }
+                delete l;
+            }
+            else
+                delete static_cast<Inner *>(t);
+            t = fa;
+        }
+        root = head = tail = NULL;
+        _size = 0;
+    }
+
+    /**
+     * destroys the elements of the leaf chain from l on and frees it.
+     */
+    static void freeLeaves(Leaf *l) {
+        while (l != NULL) {
+            Leaf *next = l->next;
+            for (int i = 0; i < l->n; ++i) {
+                l->val(i).~value_type();
+                l->key(i).~Key();
+            }
+            delete l;
+            l = next;
+        }
+    }
+
+    /**
+     * builds the tree of other's elements bottom-up in O(n): the leaves are filled evenly
+     * in one walk along other's leaves, then each level of inner nodes is built over the last.
+     * the map is only set up once everything is built; if anything throws, it stays empty.
+     */
+    void copy(const btree_map &other) {
+        size_t n = other._size;
+        if (n == 0)
+            return;
+
+        size_t cnt = (n + leafCap - 1) / leafCap;
+        Node **level = new Node *[cnt];
+        Key **low = NULL;
+        Inner **inner = NULL;
+        size_t ninner = 0;
+        Leaf *first = NULL, *last = NULL;
+        try {
+            low = new Key *[cnt];
+            // fewer inner nodes than leaves, as every inner node has at least two children
+            inner = new Inner *[cnt];
+
+            Leaf *src = other.head;
+            int si = 0;
+            for (size_t made = 0; made < cnt; ++made) {
+                Leaf *l = new Leaf;
+                l->prev = last;
+                if (last != NULL)
+                    last->next = l;
+                else
+                    first = l;
+                last = l;
+                level[made] = l;
+
+                size_t take = n / cnt + (made < n % cnt ? 1 : 0);
+                for (size_t k = 0; k < take; ++k) {
+                    if (si == src->n) {
+                        src = src->next;
+                        si = 0;
+                    }
+                    new (l->vals + l->n) value_type(src->val(si));
+                    try {
+                        new (l->keys + l->n) Key(src->key(si));
+                    }
+                    catch (...) {
+                        l->val(l->n).~value_type();
+                        throw;
+                    }
+                    l->n++;
+                    ++si;
+                }
+                low[made] = &l->key(0);
+            }
+
+            while (cnt > 1) {
+                size_t up = (cnt + innerCap - 1) / innerCap, c = 0;
+                for (size_t k = 0; k < up; ++k) {
+                    Inner *p = new Inner;
+                    inner[ninner++] = p;
+                    size_t take = cnt / up + (k < cnt % up ? 1 : 0);
+                    Key *lowest = low[c];
+                    for (size_t q = 0; q < take; ++q, ++c) {
+                        if (q > 0)
+                            new (p->keys + q - 1) Key(*low[c]);
+                        p->child[q] = level[c];
+                        p->n++;
+                    }
+                    level[k] = p;
+                    low[k] = lowest;
+                }
+                cnt = up;
+            }
+        }
+        catch (...) {
+            for (size_t k = 0; k < ninner; ++k) {
+                for (int i = 0; i + 1 < inner[k]->n; ++i)
+                    inner[k]->key(i).~Key();
+                delete inner[k];
+            }
+            freeLeaves(first);
+            delete [] level;
+            delete [] low;
+            delete [] inner;
+            throw;
+        }
+
+        for (size_t k = 0; k < ninner; ++k)
+            for (int i = 0; i < inner[k]->n; ++i)
+                inner[k]->child[i]->father = inner[k];
+        root = level[0];
+        head = first;
+        tail = last;
+        _size = n;
+        delete [] level;
+        delete [] low;
+        delete [] inner;
+    }
+
+public:
+	class const_iterator;
+	class iterator {
+	    friend class btree_map;
+	private:
+		btree_map *mp;
+		Leaf *nod;
+		int pos;
+	public:
+		iterator(btree_map *m = NULL, Leaf *n = NULL, int p = 0) : mp(m), nod(n), pos(p) {}
+		iterator(const iterator &other) : mp(other.mp), nod(other.nod), pos(other.pos) {}
+		/**
+		 * iter++ and ++iter throw invalid_iterator at end(), iter-- and --iter at begin().
+		 */
+		iterator operator++(int) {
+		    iterator ret = *this;
+		    ++*this;
+		    return ret;
+		}
+		iterator & operator++() {
+		    if (nod == NULL)
+		        throw invalid_iterator();
+		    if (++pos == nod->n) {
+		        nod = nod->next;
+		        pos = 0;
+		    }
+		    return *this;
+		}
+		iterator operator--(int) {
+		    iterator ret = *this;
+		    --*this;
+		    return ret;
+		}
+		iterator & operator--() {
+		    if (nod == NULL) {
+		        if (mp->tail == NULL)
+		            throw invalid_iterator();
+		        nod = mp->tail;
+		        pos = nod->n - 1;
+		    }
+		    else if (pos > 0)
+		        --pos;
+		    else if (nod->prev != NULL) {
+		        nod = nod->prev;
+		        pos = nod->n - 1;
+		    }
+		    else
+		        throw invalid_iterator();
+		    return *this;
+		}
+		value_type & operator*() const {
+		    if (nod == NULL)
+		        throw invalid_iterator();
+		    return nod->val(pos);
+		}
+		bool operator==(const iterator &rhs) const {
+		    return mp == rhs.mp && nod == rhs.nod && pos == rhs.pos;
+		}
+		bool operator==(const const_iterator &rhs) const {
+		    return mp == rhs.mp && nod == rhs.nod && pos == rhs.pos;
+		}
+		bool operator!=(const iterator &rhs) const {
+		    return !(*this == rhs);
+		}
+		bool operator!=(const const_iterator &rhs) const {
+		    return !(*this == rhs);
+		}
+		value_type* operator->() const noexcept {
+		    return &nod->val(pos);
+		}
+	};
+	class const_iterator {
+	    friend class btree_map;
+	private:
+		const btree_map *mp;
+		Leaf *nod;
+		int pos;
+	public:
+		const_iterator(const btree_map *m = NULL, Leaf *n = NULL, int p = 0) : mp(m), nod(n), pos(p) {}
+		const_iterator(const const_iterator &other) : mp(other.mp), nod(other.nod), pos(other.pos) {}
+		const_iterator(const iterator &other) : mp(other.mp), nod(other.nod), pos(other.pos) {}
+		const_iterator operator++(int) {
+		    const_iterator ret = *this;
+		    ++*this;
+		    return ret;
+		}
+		const_iterator & operator++() {
+		    if (nod == NULL)
+		        throw invalid_iterator();
+		    if (++pos == nod->n) {
+		        nod = nod->next;
+		        pos = 0;
+		    }
+		    return *this;
+		}
+		const_iterator operator--(int) {
+		    const_iterator ret = *this;
+		    --*this;
+		    return ret;
+		}
+		const_iterator & operator--() {
+		    if (nod == NULL) {
+		        if (mp->tail == NULL)
+		            throw invalid_iterator();
+		        nod = mp->tail;
+		        pos = nod->n - 1;
+		    }
+		    else if (pos > 0)
+		        --pos;
+		    else if (nod->prev != NULL) {
+		        nod = nod->prev;
+		        pos = nod->n - 1;
+		    }
+		    else
+		        throw invalid_iterator();
+		    return *this;
+		}
+		const value_type & operator*() const {
+		    if (nod == NULL)
+		        throw invalid_iterator();
+		    return nod->val(pos);
+		}
+		bool operator==(const iterator &rhs) const {
+		    return mp == rhs.mp && nod == rhs.nod && pos == rhs.pos;
+		}
+		bool operator==(const const_iterator &rhs) const {
+		    return mp == rhs.mp && nod == rhs.nod && pos == rhs.pos;
+		}
+		bool operator!=(const iterator &rhs) const {
+		    return !(*this == rhs);
+		}
+		bool operator!=(const const_iterator &rhs) const {
+		    return !(*this == rhs);
+		}
+		const value_type* operator->() const noexcept {
+		    return &nod->val(pos);
+		}
+	};
+
+private:
+    /**
+     * the iterator at slot i of l, which may be one past its last element.
+     */
+    iterator position(Leaf *l, int i) {
+        if (l != NULL && i == l->n) {
+            l = l->next;
+            i = 0;
+        }
+        return iterator(this, l, i);
+    }
+
+    const_iterator position(Leaf *l, int i) const {
+        if (l != NULL && i == l->n) {
+            l = l->next;
+            i = 0;
+        }
+        return const_iterator(this, l, i);
+    }
+
+public:
+	btree_map() : root(NULL), head(NULL), tail(NULL), _size(0) {}
+	btree_map(const btree_map &other) : cmp(other.cmp), root(NULL), head(NULL), tail(NULL), _size(0) {
+	    copy(other);
+	}
+	btree_map & operator=(const btree_map &other) {
+	    if (this == &other)
+	        return *this;
+
+	    clear();
+	    cmp = other.cmp;
+	    copy(other);
+	    return *this;
+	}
+	~btree_map() {
+	    clear();
+	}
+	/**
+	 * access specified element with bounds checking
+	 * throw index_out_of_bound if such key does not exist.
+	 */
+	T & at(const Key &key) {
+	    Leaf *l;
+	    int i;
+	    if (!locate(key, l, i))
+	        throw index_out_of_bound();
+	    return l->val(i).second;
+	}
+	const T & at(const Key &key) const {
+	    Leaf *l;
+	    int i;
+	    if (!locate(key, l, i))
+	        throw index_out_of_bound();
+	    return l->val(i).second;
+	}
+	/**
+	 * access specified element, inserting (key, T()) if it does not exist.
+	 */
+	T & operator[](const Key &key) {
+	    return try_emplace(key).first->second;
+	}
+	/**
+	 * behave like at() throw index_out_of_bound if such key does not exist.
+	 */
+	const T & operator[](const Key &key) const {
+	    return at(key);
+	}
+	iterator begin() {
+	    return iterator(this, head, 0);
+	}
+	const_iterator cbegin() const {
+	    return const_iterator(this, head, 0);
+	}
+	iterator end() {
+	    return iterator(this, NULL, 0);
+	}
+	const_iterator cend() const {
+	    return const_iterator(this, NULL, 0);
+	}
+	bool empty() const {
+	    return _size == 0;
+	}
+	size_t size() const {
+	    return _size;
+	}
+	void clear() {
+	    makeEmpty();
+	}
+	/**
+	 * insert an element.
+	 * return the iterator to the new element (or the element that prevented the insertion)
+	 *   and whether it was inserted.
+	 */
+	pair<iterator, bool> insert(const value_type &value) {
+	    Leaf *l;
+	    int i;
+	    if (locate(value.first, l, i))
+	        return pair<iterator, bool>(iterator(this, l, i), false);
+	    Entry e(value);
+	    pair<Leaf *, int> r = insertAt(l, i, e);
+	    return pair<iterator, bool>(iterator(this, r.first, r.second), true);
+	}
+	/**
+	 * insert with a hint: value is expected to go just before hint (end() to append).
+	 * then no descent is made, otherwise it falls back to insert(value).
+	 * returns the iterator to the new element or to the one that prevented the insertion.
+	 * throw invalid_iterator if hint points to another map.
+	 */
+	iterator insert(iterator hint, const value_type &value) {
+	    if (hint.mp != this)
+	        throw invalid_iterator();
+
+	    Leaf *l = hint.nod;
+	    int i = hint.pos;
+	    if (l == NULL) {
+	        l = tail;
+	        i = l == NULL ? 0 : l->n;
+	    }
+	    // the slot must lie inside l: before its first key the element may belong to the leaf on the left
+	    bool fits = l == NULL || ((i > 0 || l == head)
+	        && (i == 0 || cmp(l->key(i - 1), value.first))
+	        && (i == l->n || cmp(value.first, l->key(i))));
+	    if (!fits)
+	        return insert(value).first;
+	    Entry e(value);
+	    pair<Leaf *, int> r = insertAt(l, i, e);
+	    return iterator(this, r.first, r.second);
+	}
+	/**
+	 * inserts (key, T(args...)) if key is absent, in a single descent.
+	 * if key is present nothing is constructed, and args are left untouched.
+	 * return like insert(value).
+	 */
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const Key &key, Args&&... args) {
+	    Leaf *l;
+	    int i;
+	    if (locate(key, l, i))
+	        return pair<iterator, bool>(iterator(this, l, i), false);
+	    Entry e(key, T(std::forward<Args>(args)...));
+	    pair<Leaf *, int> r = insertAt(l, i, e);
+	    return pair<iterator, bool>(iterator(this, r.first, r.second), true);
+	}
+	/**
+	 * assigns obj to the element with key, or inserts (key, obj), in a single descent.
+	 * the second one of the result is true if it was inserted.
+	 */
+	template<class M>
+	pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+	    Leaf *l;
+	    int i;
+	    if (locate(key, l, i)) {
+	        l->val(i).second = std::forward<M>(obj);
+	        return pair<iterator, bool>(iterator(this, l, i), false);
+	    }
+	    Entry e(key, std::forward<M>(obj));
+	    pair<Leaf *, int> r = insertAt(l, i, e);
+	    return pair<iterator, bool>(iterator(this, r.first, r.second), true);
+	}
+	/**
+	 * erase the element at pos, returns the iterator to the element after it.
+	 * throw invalid_iterator if pos is end() or points to another map.
+	 */
+	iterator erase(iterator pos) {
+	    if (pos.mp != this || pos.nod == NULL)
+	        throw invalid_iterator();
+	    pair<Leaf *, int> r = eraseAt(pos.nod, pos.pos);
+	    return position(r.first, r.second);
+	}
+	/**
+	 * erase the elements in [first, last), O(k) moves for k elements; the whole map is simply cleared.
+	 * returns the iterator to the element last pointed to (last itself is invalidated like any other).
+	 *
+	 * throw invalid_iterator if first or last points out of this, or last is not reached from first.
+	 */
+	iterator erase(iterator first, iterator last) {
+	    if (first.mp != this || last.mp != this)
+	        throw invalid_iterator();
+	    // counted leaf by leaf before anything is erased
+	    size_t k = 0;
+	    Leaf *l = first.nod;
+	    int i = first.pos;
+	    while (l != last.nod) {
+	        if (l == NULL)
+	            throw invalid_iterator();
+	        k += l->n - i;
+	        l = l->next;
+	        i = 0;
+	    }
+	    if (l != NULL && last.pos < i)
+	        throw invalid_iterator();
+	    if (l != NULL)
+	        k += last.pos - i;
+
+	    if (k == _size) {
+	        clear();
+	        return end();
+	    }
+	    l = first.nod;
+	    i = first.pos;
+	    for (; k > 0; --k) {
+	        if (i == l->n) {
+	            l = l->next;
+	            i = 0;
+	        }
+	        pair<Leaf *, int> r = eraseAt(l, i);
+	        l = r.first;
+	        i = r.second;
+	    }
+	    return position(l, i);
+	}
+	/**
+	 * erase the element with key if there is one, returns the number erased (0 or 1).
+	 */
+	size_t erase(const Key &key) {
+	    Leaf *l;
+	    int i;
+	    if (!locate(key, l, i))
+	        return 0;
+	    eraseAt(l, i);
+	    return 1;
+	}
+	size_t count(const Key &key) const {
+	    Leaf *l;
+	    int i;
+	    return locate(key, l, i) ? 1 : 0;
+	}
+	iterator find(const Key &key) {
+	    Leaf *l;
+	    int i;
+	    if (!locate(key, l, i))
+	        return end();
+	    return iterator(this, l, i);
+	}
+	const_iterator find(const Key &key) const {
+	    Leaf *l;
+	    int i;
+	    if (!locate(key, l, i))
+	        return cend();
+	    return const_iterator(this, l, i);
+	}
+	/**
+	 * the first element whose key is not less than key, and the first one whose key is greater.
+	 */
+	iterator lower_bound(const Key &key) {
+	    Leaf *l = leafOf(key);
+	    return l == NULL ? end() : position(l, lower(l, key));
+	}
+	const_iterator lower_bound(const Key &key) const {
+	    Leaf *l = leafOf(key);
+	    return l == NULL ? cend() : position(l, lower(l, key));
+	}
+	iterator upper_bound(const Key &key) {
+	    Leaf *l = leafOf(key);
+	    return l == NULL ? end() : position(l, upper(l, key));
+	}
+	const_iterator upper_bound(const Key &key) const {
+	    Leaf *l = leafOf(key);
+	    return l == NULL ? cend() : position(l, upper(l, key));
+	}
+};
+
+}
+
+#endif
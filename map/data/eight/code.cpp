@@ -0,0 +1,122 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+int built = 0;
+
+class Counted{
+public:
+	int v;
+	Counted(int v = 0) : v(v) { built++; }
+	Counted(const Counted &other) : v(other.v) { built++; }
+	Counted & operator=(const Counted &other) { v = other.v; return *this; }
+};
+
+unsigned int seed = 1234567;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+template<class M, class S>
+bool same(M &Q, S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::iterator it = Q.begin();
+	for(typename S::iterator stdit = stdQ.begin(); stdit != stdQ.end(); ++it, ++stdit){
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	return it == Q.end();
+}
+
+bool check1(){ //try_emplace builds nothing for a present key
+	sjtu::map<int, Counted> Q;
+	for(int i = 0; i < 1000; i++){
+		if(!Q.try_emplace(i, i * 3).second) return 0;
+	}
+	built = 0;
+	for(int i = 0; i < 1000; i++){
+		sjtu::pair<sjtu::map<int, Counted>::iterator, bool> r = Q.try_emplace(i, -1);
+		if(r.second || r.first -> second.v != i * 3) return 0;
+		if(Q[i].v != i * 3) return 0;
+	}
+	if(built != 0) return 0;
+	sjtu::pair<sjtu::map<int, Counted>::iterator, bool> r = Q.try_emplace(5000);
+	return r.second && r.first -> second.v == 0 && Q.size() == 1001;
+}
+
+bool check2(){ //insert_or_assign
+	sjtu::map<string, string> Q;
+	if(!Q.insert_or_assign("a", string("1")).second) return 0;
+	if(!Q.insert_or_assign("b", "2").second) return 0;
+	sjtu::pair<sjtu::map<string, string>::iterator, bool> r = Q.insert_or_assign("a", "3");
+	if(r.second || r.first -> first != "a" || r.first -> second != "3") return 0;
+	return Q.size() == 2 && Q["a"] == "3" && Q["b"] == "2";
+}
+
+bool check3(){ //hinted inserts at the ends
+	sjtu::map<int, int> Q;
+	std::map<int, int> stdQ;
+	for(int i = 0; i < 200000; i++){
+		sjtu::map<int, int>::iterator it = Q.insert(Q.end(), sjtu::map<int, int>::value_type(i, i));
+		stdQ[i] = i;
+		if(it -> first != i) return 0;
+	}
+	for(int i = -1; i > -200000; i--){
+		sjtu::map<int, int>::iterator it = Q.insert(Q.begin(), sjtu::map<int, int>::value_type(i, i));
+		stdQ[i] = i;
+		if(it != Q.begin()) return 0;
+	}
+	//the hint holds the key: nothing changes
+	sjtu::map<int, int>::iterator it = Q.insert(Q.find(7), sjtu::map<int, int>::value_type(7, 100));
+	if(it -> first != 7 || it -> second != 7) return 0;
+	return same(Q, stdQ);
+}
+
+template<class Balance>
+bool check4(){ //any hint, right or wrong, gives the same map
+	sjtu::map<int, int, std::less<int>, Balance> Q;
+	std::map<int, int> stdQ;
+	typename sjtu::map<int, int, std::less<int>, Balance>::iterator last = Q.end();
+	for(int i = 0; i < 100000; i++){
+		int a = randNum(50000), op = randNum(3);
+		typename sjtu::map<int, int, std::less<int>, Balance>::iterator hint;
+		if(op == 0) hint = Q.find(a + 1);
+		else if(op == 1) hint = last;
+		else hint = Q.end();
+		last = Q.insert(hint, typename sjtu::map<int, int, std::less<int>, Balance>::value_type(a, i));
+		stdQ.insert(std::map<int, int>::value_type(a, i));
+		if(last -> first != a || last -> second != stdQ[a]) return 0;
+		if(randNum(4) == 0){
+			int b = randNum(50000);
+			typename sjtu::map<int, int, std::less<int>, Balance>::iterator e = Q.find(b);
+			if(e != Q.end()){
+				if(e == last) last = Q.end();
+				Q.erase(e);
+				stdQ.erase(b);
+			}
+		}
+	}
+	return same(Q, stdQ);
+}
+
+bool check5(){ //bad hint
+	sjtu::map<int, int> Q, P;
+	try { Q.insert(P.end(), sjtu::map<int, int>::value_type(1, 1)); } catch(...) { return Q.empty(); }
+	return 0;
+}
+
+int main(){
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4<sjtu::avl_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check4<sjtu::rb_balance>()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	if(!check4<sjtu::splay_balance>()) cout << "Test 6 Failed......" << endl; else cout << "Test 6 Passed!" << endl;
+	if(!check5()) cout << "Test 7 Failed......" << endl; else cout << "Test 7 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+unsigned int seed = 2468013;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+struct max_of{
+	long long operator()(long long a, long long b) const { return a < b ? b : a; }
+};
+
+//rank, select, count_range and aggregate_range against a walk over std::map
+template<class Balance>
+bool check(){
+	typedef sjtu::map<int, long long, std::less<int>, Balance, sjtu::subtree_aggregate<long long> > M;
+	M Q;
+	std::map<int, long long> stdQ;
+	for(int round = 0; round < 4; round++){
+		for(int i = 0; i < 3000; i++){
+			int a = randNum(20000), op = randNum(6);
+			if(op < 2){ Q[a] = i; Q.refresh(Q.find(a)); stdQ[a] = i; }
+			else if(op == 2){ Q.insert_or_assign(a, (long long)-i); stdQ[a] = -i; }
+			else if(op == 3){ if(Q.erase(a) != stdQ.erase(a)) return 0; }
+			else if(op == 4){ Q.insert(Q.end(), sjtu::pair<const int, long long>(a, i)); stdQ.insert(std::make_pair(a, (long long)i)); }
+			else { Q.find(a); Q.count(a); }
+		}
+		if(Q.size() != stdQ.size()) return 0;
+		size_t k = 0;
+		for(std::map<int, long long>::iterator it = stdQ.begin(); it != stdQ.end(); ++it, ++k){
+			if(Q.rank(it -> first) != k) return 0;
+			if(Q.rank(it -> first + 1) != k + 1) return 0;
+			typename M::iterator s = Q.select(k);
+			if(s -> first != it -> first || s -> second != it -> second) return 0;
+		}
+		for(int i = 0; i < 2000; i++){
+			int lo = randNum(21000) - 500, hi = lo + randNum(3000) - 100;
+			size_t cnt = 0;
+			long long sum = 0;
+			for(std::map<int, long long>::iterator it = stdQ.lower_bound(lo); it != stdQ.end() && it -> first < hi; ++it){
+				cnt++;
+				sum += it -> second;
+			}
+			if(Q.count_range(lo, hi) != cnt) return 0;
+			bool thrown = 0;
+			long long got = 0;
+			try { got = Q.aggregate_range(lo, hi); } catch(sjtu::container_is_empty &) { thrown = 1; }
+			if(thrown != (cnt == 0) || (!thrown && got != sum)) return 0;
+		}
+		const M P(Q);
+		for(int i = 0; i < 200; i++){
+			size_t j = randNum((int)P.size());
+			typename M::const_iterator a = P.select(j);
+			if(a -> first != Q.select(j) -> first) return 0;
+			if(P.aggregate_range(-1, 30000) != Q.aggregate_range(-1, 30000)) return 0;
+		}
+		if(round == 1){ while(Q.size() > 5) Q.erase(Q.select(randNum((int)Q.size()))); stdQ.clear(); for(typename M::iterator it = Q.begin(); it != Q.end(); ++it) stdQ[it -> first] = it -> second; }
+	}
+	return 1;
+}
+
+bool check5(){ //string concatenation is not commutative: values come in key order
+	sjtu::map<int, string, std::less<int>, sjtu::avl_balance, sjtu::subtree_aggregate<string> > Q;
+	std::map<int, string> stdQ;
+	for(int i = 0; i < 2000; i++){
+		int a = randNum(500);
+		string s(1, (char)('a' + randNum(26)));
+		Q.insert_or_assign(a, s);
+		stdQ[a] = s;
+		if(randNum(3) == 0){ int b = randNum(500); Q.erase(b); stdQ.erase(b); }
+	}
+	for(int i = 0; i < 300; i++){
+		int lo = randNum(500), hi = lo + 1 + randNum(200);
+		string want;
+		for(std::map<int, string>::iterator it = stdQ.lower_bound(lo); it != stdQ.end() && it -> first < hi; ++it) want += it -> second;
+		if(want.empty()) continue;
+		if(Q.aggregate_range(lo, hi) != want) return 0;
+	}
+	return 1;
+}
+
+bool check6(){ //a leaderboard: best score in a window of ids, percentile of a player
+	sjtu::map<int, long long, std::less<int>, sjtu::rb_balance, sjtu::subtree_aggregate<long long, max_of> > board;
+	for(int id = 0; id < 1000; id++) board[id] = (id * 7919) % 1000;
+	board[500] = 5000;
+	board.refresh(board.find(500));
+	long long before = 0, after = 0;
+	for(int id = 0; id < 500; id++) before = max(before, (long long)(id * 7919) % 1000);
+	for(int id = 501; id < 1000; id++) after = max(after, (long long)(id * 7919) % 1000);
+	if(board.aggregate_range(0, 1000) != 5000 || board.aggregate_range(0, 500) != before) return 0;
+	if(board.aggregate_range(501, 1000) != after) return 0;
+	board.insert_or_assign(500, 0LL);
+	if(board.aggregate_range(500, 501) != 0) return 0;
+	if(board.rank(250) != 250 || board.count_range(100, 200) != 100 || board.count_range(200, 100) != 0) return 0;
+	int caught = 0;
+	try { board.aggregate_range(2000, 3000); } catch(sjtu::container_is_empty &) { caught++; }
+	try { board.aggregate_range(10, 10); } catch(sjtu::container_is_empty &) { caught++; }
+	try { board.select(1000); } catch(sjtu::index_out_of_bound &) { caught++; }
+	try { board.refresh(board.end()); } catch(sjtu::invalid_iterator &) { caught++; }
+	board.clear();
+	try { board.select(0); } catch(sjtu::index_out_of_bound &) { caught++; }
+	return caught == 5 && board.rank(3) == 0;
+}
+
+bool check7(){ //subtree_size alone, with the splay policy rotating on every lookup
+	sjtu::map<int, int, std::less<int>, sjtu::splay_balance, sjtu::subtree_size> Q;
+	for(int i = 0; i < 100000; i++) Q[i * 2] = i;
+	for(int i = 0; i < 100000; i++){
+		int k = randNum(100000);
+		if(Q.select(k) -> first != 2 * k) return 0;
+		if(Q.rank(2 * k + 1) != (size_t)k + 1) return 0;
+		Q.find(randNum(200000));
+	}
+	sjtu::map<int, int, std::less<int>, sjtu::splay_balance, sjtu::subtree_size> P;
+	P = Q;
+	for(int i = 0; i < 50000; i++) P.erase(P.begin());
+	return P.select(0) -> first == 100000 && P.rank(199999) == 50000 && Q.count_range(0, 200000) == 100000;
+}
+
+int main(){
+	if(!check<sjtu::avl_balance>()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check<sjtu::rb_balance>()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check<sjtu::treap_balance>()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check<sjtu::splay_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	if(!check6()) cout << "Test 6 Failed......" << endl; else cout << "Test 6 Passed!" << endl;
+	if(!check7()) cout << "Test 7 Failed......" << endl; else cout << "Test 7 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include<iostream>
+#include<map>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+unsigned int seed = 7654321;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+template<class M, class S>
+bool same(M &Q, S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::iterator it = Q.begin();
+	for(typename S::iterator stdit = stdQ.begin(); stdit != stdQ.end(); ++it, ++stdit){
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	return it == Q.end();
+}
+
+template<class Balance>
+bool check(){
+	typedef sjtu::map<int, int, std::less<int>, Balance> M;
+	M Q;
+	std::map<int, int> stdQ;
+	for(int i = 0; i < 100000; i++){
+		int a = randNum(1000000);
+		Q[a] = i; stdQ[a] = i;
+	}
+	//erase returns the next element
+	for(int i = 0; i < 1000; i++){
+		int a = randNum(1000000);
+		typename M::iterator it = Q.find(a);
+		std::map<int, int>::iterator stdit = stdQ.find(a);
+		if(it == Q.end()) continue;
+		it = Q.erase(it);
+		stdit = stdQ.erase(stdit);
+		if((it == Q.end()) != (stdit == stdQ.end())) return 0;
+		if(it != Q.end() && it -> first != stdit -> first) return 0;
+	}
+	//erase by key
+	for(int i = 0; i < 20000; i++){
+		int a = randNum(1000000);
+		if(Q.erase(a) != stdQ.erase(a)) return 0;
+	}
+	if(!same(Q, stdQ)) return 0;
+	//ranges in the middle, at the front, at the back and empty ones
+	for(int i = 0; i < 200; i++){
+		int a = randNum(1000000), b = a + randNum(20000);
+		typename M::iterator first = Q.begin(), last = Q.begin();
+		while(first != Q.end() && first -> first < a) ++first;
+		last = first;
+		while(last != Q.end() && last -> first < b) ++last;
+		typename M::iterator r = Q.erase(first, last);
+		if(r != last) return 0;
+		stdQ.erase(stdQ.lower_bound(a), stdQ.lower_bound(b));
+	}
+	if(!same(Q, stdQ)) return 0;
+	typename M::iterator mid = Q.begin();
+	for(int i = 0; i < 1000; i++) ++mid;
+	typename M::iterator r = Q.erase(Q.begin(), mid);
+	if(r != mid || r != Q.begin()) return 0;
+	stdQ.erase(stdQ.begin(), stdQ.find(mid -> first));
+	mid = Q.end();
+	for(int i = 0; i < 1000; i++) --mid;
+	int k = mid -> first;
+	r = Q.erase(mid, Q.end());
+	if(r != Q.end()) return 0;
+	stdQ.erase(stdQ.find(k), stdQ.end());
+	r = Q.erase(Q.begin(), Q.begin());
+	if(r != Q.begin()) return 0;
+	if(!same(Q, stdQ)) return 0;
+	//everything
+	M P(Q);
+	if(P.erase(P.begin(), P.end()) != P.end() || !P.empty()) return 0;
+	P[1] = 1;
+	if(P.size() != 1 || P.begin() -> first != 1) return 0;
+	while(!Q.empty()) Q.erase(Q.begin());
+	return Q.begin() == Q.end();
+}
+
+bool check5(){ //bad ranges
+	sjtu::map<int, int> Q, P;
+	Q[1] = 1; P[1] = 1;
+	int caught = 0;
+	try { Q.erase(P.begin(), Q.end()); } catch(...) { caught++; }
+	try { Q.erase(Q.begin(), P.end()); } catch(...) { caught++; }
+	try { Q.erase(Q.end(), Q.begin()); } catch(...) { caught++; }
+	//a reversed range is refused before anything is erased
+	for(int i = 2; i <= 10; i++) Q[i] = i;
+	sjtu::map<int, int>::iterator lo = Q.find(3), hi = Q.find(8);
+	try { Q.erase(hi, lo); } catch(sjtu::invalid_iterator &) { caught++; }
+	if(Q.size() != 10) return 0;
+	for(int i = 1; i <= 10; i++) if(Q.count(i) != 1 || Q[i] != i) return 0;
+	if(Q.erase(lo, hi) != hi || Q.size() != 5 || Q.count(3) || !Q.count(8)) return 0;
+	for(int i = 10; i > 1; i--) Q.erase(i);
+	return caught == 4 && Q.size() == 1 && P.size() == 1;
+}
+
+int main(){
+	if(!check<sjtu::avl_balance>()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check<sjtu::rb_balance>()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check<sjtu::treap_balance>()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check<sjtu::splay_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,92 @@
+#include<iostream>
+#include<map>
+#include<vector>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+unsigned int seed = 20170417;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+template<class M, class S>
+bool same(const M &Q, const S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::const_iterator it = Q.cbegin();
+	typename S::const_iterator stdit = stdQ.begin();
+	for(; stdit != stdQ.end(); ++it, ++stdit){
+		if(it == Q.cend()) return 0;
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	if(it != Q.cend()) return 0;
+	typename S::const_reverse_iterator rit = stdQ.rbegin();
+	for(; rit != stdQ.rend(); ++rit){
+		--it;
+		if(it -> first != rit -> first) return 0;
+	}
+	return 1;
+}
+
+template<class Balance>
+bool check(){
+	typedef sjtu::map<int, int, std::less<int>, Balance> M;
+	M Q;
+	std::map<int, int> stdQ;
+	//sorted, then mixed random operations
+	for(int i = 0; i < 100000; i++){
+		Q[i] = i; stdQ[i] = i;
+	}
+	for(int i = 0; i < 300000; i++){
+		int a = randNum(200000), op = randNum(4);
+		if(op == 0){
+			Q[a] = i; stdQ[a] = i;
+		}
+		else if(op == 1){
+			if(Q.insert(typename M::value_type(a, i)).second != stdQ.insert(std::map<int, int>::value_type(a, i)).second) return 0;
+		}
+		else if(op == 2){
+			typename M::iterator it = Q.find(a);
+			if((it == Q.end()) != (stdQ.count(a) == 0)) return 0;
+			if(it != Q.end()){
+				Q.erase(it);
+				stdQ.erase(a);
+			}
+		}
+		else{
+			if(Q.count(a) != stdQ.count(a)) return 0;
+			if(stdQ.count(a) && Q.at(a) != stdQ[a]) return 0;
+		}
+	}
+	if(!same(Q, stdQ)) return 0;
+	//copies keep their own shape
+	M P(Q), R;
+	R = P;
+	for(std::map<int, int>::iterator it = stdQ.begin(); it != stdQ.end(); ++it)
+		Q.erase(Q.find(it -> first));
+	if(!Q.empty() || Q.begin() != Q.end()) return 0;
+	if(!same(P, stdQ) || !same(R, stdQ)) return 0;
+	//iterators survive lookups and erasing other elements
+	vector<typename M::iterator> its;
+	for(int i = 0; i < 50000; i++) its.push_back(Q.insert(typename M::value_type(i * 7 % 50000, i)).first);
+	for(int i = 0; i < 50000; i += 3){
+		Q.find(randNum(50000));
+		Q.erase(its[i]);
+	}
+	for(int i = 0; i < 50000; i++){
+		if(i % 3 == 0) continue;
+		if(its[i] -> first != i * 7 % 50000 || its[i] -> second != i) return 0;
+	}
+	return Q.size() == 50000 - 16667;
+}
+
+int main(){
+	if(!check<sjtu::avl_balance>()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check<sjtu::rb_balance>()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check<sjtu::treap_balance>()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check<sjtu::splay_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	return 0;
+}
@@ -0,0 +1,123 @@
+#include<iostream>
+#include<map>
+#include<vector>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+const int N = 1000000;
+
+unsigned int seed = 19260817;
+int randNum(){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % 1000000);
+}
+
+template<class M, class S>
+bool same(const M &Q, const S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::const_iterator it = Q.cbegin();
+	typename S::const_iterator stdit = stdQ.begin();
+	for(; stdit != stdQ.end(); ++it, ++stdit){
+		if(it == Q.cend()) return 0;
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	return it == Q.cend();
+}
+
+bool check1(){ //sorted keys
+	sjtu::map<int, int> Q;
+	for(int i = 0; i < N; i++) Q[i] = i * 2;
+	if(Q.size() != (size_t)N) return 0;
+	for(int i = 0; i < N; i++){
+		if(Q.at(i) != i * 2) return 0;
+	}
+	int k = 0;
+	for(sjtu::map<int, int>::iterator it = Q.begin(); it != Q.end(); ++it, ++k){
+		if(it -> first != k) return 0;
+	}
+	if(k != N) return 0;
+	sjtu::map<int, int>::iterator it = Q.end();
+	for(int i = N - 1; i >= 0; i--){
+		--it;
+		if(it -> first != i) return 0;
+	}
+	for(int i = 0; i < N; i++) Q.erase(Q.begin());
+	return Q.empty() && Q.begin() == Q.end();
+}
+
+bool check2(){ //reverse sorted keys, erase every other
+	sjtu::map<int, int> Q;
+	std::map<int, int> stdQ;
+	for(int i = N; i > 0; i--){
+		Q.insert(sjtu::map<int, int>::value_type(i, -i));
+		stdQ.insert(std::map<int, int>::value_type(i, -i));
+	}
+	for(int i = 1; i <= N; i += 2){
+		Q.erase(Q.find(i));
+		stdQ.erase(i);
+	}
+	for(int i = N; i > N / 2; i -= 2){
+		Q.erase(Q.find(i));
+		stdQ.erase(i);
+	}
+	return same(Q, stdQ);
+}
+
+bool check3(){ //random inserts and erases
+	sjtu::map<int, int> Q;
+	std::map<int, int> stdQ;
+	for(int round = 0; round < 20; round++){
+		for(int i = 0; i < 20000; i++){
+			int a = randNum(), b = randNum();
+			Q[a] = b; stdQ[a] = b;
+		}
+		for(int i = 0; i < 15000; i++){
+			int a = randNum();
+			sjtu::map<int, int>::iterator it = Q.find(a);
+			if((it == Q.end()) != (stdQ.count(a) == 0)) return 0;
+			if(it != Q.end()){
+				Q.erase(it);
+				stdQ.erase(a);
+			}
+		}
+		if(!same(Q, stdQ)) return 0;
+	}
+	sjtu::map<int, int> P(Q), R;
+	R = Q;
+	Q.clear();
+	return same(P, stdQ) && same(R, stdQ) && Q.empty();
+}
+
+bool check4(){ //iterators survive erasing other elements
+	sjtu::map<int, int> Q;
+	vector<sjtu::map<int, int>::iterator> its;
+	for(int i = 0; i < 100000; i++) its.push_back(Q.insert(sjtu::map<int, int>::value_type(i * 7 % 100000, i)).first);
+	for(int i = 0; i < 100000; i += 3) Q.erase(its[i]);
+	for(int i = 0; i < 100000; i++){
+		if(i % 3 == 0) continue;
+		if(its[i] -> first != i * 7 % 100000 || its[i] -> second != i) return 0;
+	}
+	return Q.size() == 100000 - 33334;
+}
+
+bool check5(){ //bad iterators
+	sjtu::map<int, int> Q, P;
+	Q[1] = 1; P[1] = 1;
+	int caught = 0;
+	try { Q.erase(Q.end()); } catch(...) { caught++; }
+	try { Q.erase(P.begin()); } catch(...) { caught++; }
+	try { Q.at(2); } catch(...) { caught++; }
+	return caught == 3 && Q.size() == 1 && P.size() == 1;
+}
+
+int main(){
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
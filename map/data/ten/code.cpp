@@ -0,0 +1,262 @@
+#include<iostream>
+#include<map>
+#include<string>
+#include<cstdio>
+#include<cstdlib>
+#include "btree_map.hpp"
+
+using namespace std;
+
+unsigned int seed = 998244353;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+class Key{
+public:
+	int x;
+	Key(const Key &other):x(other.x){}
+	Key(int x):x(x){}
+};
+struct cmp{
+	bool operator ()(const Key &a,const Key &b)const{return a.x > b.x;}
+};
+
+string name(int i){
+	char buf[32];
+	sprintf(buf, "word%07d", i);
+	return buf;
+}
+
+template<class M, class S>
+bool same(const M &Q, const S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::const_iterator it = Q.cbegin();
+	for(typename S::const_iterator stdit = stdQ.begin(); stdit != stdQ.end(); ++it, ++stdit){
+		if(it == Q.cend()) return 0;
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	if(it != Q.cend()) return 0;
+	for(typename S::const_reverse_iterator rit = stdQ.rbegin(); rit != stdQ.rend(); ++rit){
+		--it;
+		if(it -> first != rit -> first) return 0;
+	}
+	return 1;
+}
+
+bool check1(){ //random operations on int keys
+	sjtu::btree_map<int, int> Q;
+	std::map<int, int> stdQ;
+	for(int i = 0; i < 400000; i++){
+		int a = randNum(100000), op = randNum(5);
+		if(op < 2){
+			Q[a] = i; stdQ[a] = i;
+		}
+		else if(op == 2){
+			if(Q.insert(sjtu::btree_map<int, int>::value_type(a, i)).second != stdQ.insert(std::map<int, int>::value_type(a, i)).second) return 0;
+		}
+		else if(op == 3){
+			sjtu::btree_map<int, int>::iterator it = Q.find(a);
+			if((it == Q.end()) != (stdQ.count(a) == 0)) return 0;
+			if(it != Q.end()){
+				it = Q.erase(it);
+				std::map<int, int>::iterator stdit = stdQ.erase(stdQ.find(a));
+				if((it == Q.end()) != (stdit == stdQ.end())) return 0;
+				if(it != Q.end() && it -> first != stdit -> first) return 0;
+			}
+		}
+		else{
+			if(Q.erase(a) != stdQ.erase(a)) return 0;
+		}
+	}
+	return same(Q, stdQ);
+}
+
+bool check2(){ //sorted load, scans and bounds
+	sjtu::btree_map<int, int> Q;
+	for(int i = 0; i < 1000000; i++) Q[i * 2] = i;
+	long long sum = 0;
+	for(sjtu::btree_map<int, int>::iterator it = Q.begin(); it != Q.end(); ++it) sum += it -> second;
+	if(sum != 1000000LL * 999999 / 2) return 0;
+	for(int i = 0; i < 100000; i++){
+		int a = randNum(2000002);
+		sjtu::btree_map<int, int>::iterator lo = Q.lower_bound(a), hi = Q.upper_bound(a);
+		int want = (a + 1) / 2 * 2;
+		if(want >= 2000000){
+			if(lo != Q.end()) return 0;
+		}
+		else if(lo -> first != want) return 0;
+		int next = a / 2 * 2 + 2;
+		if(next >= 2000000){
+			if(hi != Q.end()) return 0;
+		}
+		else if(hi -> first != next) return 0;
+	}
+	while(Q.size() > 10) Q.erase(Q.begin());
+	return Q.begin() -> first == 1999980;
+}
+
+bool check3(){ //string keys and values, copies
+	sjtu::btree_map<string, string> Q;
+	std::map<string, string> stdQ;
+	for(int i = 0; i < 100000; i++){
+		int a = randNum(20000);
+		if(randNum(3)){
+			Q[name(a)] = name(i); stdQ[name(a)] = name(i);
+		}
+		else{
+			if(Q.erase(name(a)) != stdQ.erase(name(a))) return 0;
+		}
+	}
+	sjtu::btree_map<string, string> P(Q), R;
+	R = P;
+	Q.clear();
+	if(!Q.empty() || Q.begin() != Q.end()) return 0;
+	const sjtu::btree_map<string, string> &C = R;
+	for(std::map<string, string>::iterator it = stdQ.begin(); it != stdQ.end(); ++it){
+		if(C.at(it -> first) != it -> second || C.count(it -> first) != 1) return 0;
+	}
+	return same(P, stdQ) && same(R, stdQ);
+}
+
+bool check4(){ //no default constructor, reversed order
+	sjtu::btree_map<Key, int, cmp> Q;
+	for(int i = 0; i < 30000; i++) Q[Key(randNum(10000))] = i;
+	int last = 1 << 30;
+	for(sjtu::btree_map<Key, int, cmp>::iterator it = Q.begin(); it != Q.end(); ++it){
+		if(it -> first.x >= last) return 0;
+		last = it -> first.x;
+	}
+	for(int i = 0; i < 10000; i++) Q.erase(Key(i));
+	return Q.empty();
+}
+
+bool check5(){ //bad iterators
+	sjtu::btree_map<int, int> Q, P;
+	Q[1] = 1; P[1] = 1;
+	int caught = 0;
+	try { Q.erase(Q.end()); } catch(...) { caught++; }
+	try { Q.erase(P.begin()); } catch(...) { caught++; }
+	try { Q.at(2); } catch(...) { caught++; }
+	try { sjtu::btree_map<int, int>::iterator it = Q.begin(); --it; } catch(...) { caught++; }
+	try { sjtu::btree_map<int, int>::iterator it = Q.end(); ++it; } catch(...) { caught++; }
+	try { sjtu::btree_map<int, int> E; E.end()--; } catch(...) { caught++; }
+	return caught == 6 && Q.size() == 1 && P.size() == 1;
+}
+
+int alive = 0, copies = 0, budget = -1;
+class FragileKey{
+public:
+	int x;
+	FragileKey(int x):x(x){ alive++; }
+	FragileKey(const FragileKey &other):x(other.x){
+		if(budget == 0) throw 1;
+		if(budget > 0) budget--;
+		copies++;
+		alive++;
+	}
+	~FragileKey(){ alive--; }
+};
+struct fragileLess{
+	bool operator ()(const FragileKey &a,const FragileKey &b)const{return a.x < b.x;}
+};
+
+bool check6(){ //a copy throwing in any level leaves nothing behind
+	typedef sjtu::btree_map<FragileKey, int, fragileLess> M;
+	{
+		M Q;
+		for(int i = 0; i < 5000; i++) Q[FragileKey(i * 7)] = i;
+		int before = alive;
+		copies = 0;
+		{ M P(Q); }
+		int total = copies;
+		if(alive != before) return 0;
+		int budgets[] = {total - 1, total - 3, total / 2, 1, 0};
+		for(int k = 0; k < 5; k++){
+			budget = budgets[k];
+			bool thrown = 0;
+			try { M P(Q); } catch(int) { thrown = 1; }
+			budget = -1;
+			if(!thrown || alive != before) return 0;
+			M R;
+			R[FragileKey(1)] = 1;
+			budget = budgets[k];
+			thrown = 0;
+			try { R = Q; } catch(int) { thrown = 1; }
+			budget = -1;
+			if(!thrown || !R.empty() || R.find(FragileKey(7)) != R.end() || R.begin() != R.end()) return 0;
+			if(alive != before) return 0;
+		}
+		if(Q.size() != 5000 || Q.at(FragileKey(35)) != 5) return 0;
+	}
+	return alive == 0;
+}
+
+bool check7(){ //hinted insert, try_emplace, insert_or_assign, range erase
+	typedef sjtu::btree_map<int, int> M;
+	M Q;
+	std::map<int, int> stdQ;
+	for(int i = 0; i < 300000; i++){
+		int a = randNum(60000), op = randNum(8);
+		if(op < 2){
+			M::iterator hint = randNum(2) ? Q.lower_bound(a) : Q.lower_bound(randNum(60000));
+			M::iterator it = Q.insert(hint, M::value_type(a, i));
+			stdQ.insert(std::map<int, int>::value_type(a, i));
+			if(it -> first != a || it -> second != stdQ[a]) return 0;
+		}
+		else if(op == 2){
+			M::iterator it = Q.insert(Q.end(), M::value_type(a + 60000, i));
+			stdQ.insert(std::map<int, int>::value_type(a + 60000, i));
+			if(it -> first != a + 60000) return 0;
+		}
+		else if(op == 3){
+			bool in = Q.try_emplace(a, i).second;
+			if(in != stdQ.insert(std::map<int, int>::value_type(a, i)).second) return 0;
+		}
+		else if(op == 4){
+			if(Q.insert_or_assign(a, i).second != (stdQ.count(a) == 0)) return 0;
+			stdQ[a] = i;
+		}
+		else if(op == 5 && randNum(20) == 0){
+			int b = a + randNum(3000);
+			M::iterator it = Q.erase(Q.lower_bound(a), Q.lower_bound(b));
+			stdQ.erase(stdQ.lower_bound(a), stdQ.lower_bound(b));
+			std::map<int, int>::iterator sit = stdQ.lower_bound(b);
+			if(sit == stdQ.end() ? it != Q.end() : it -> first != sit -> first) return 0;
+		}
+		else if(op == 6){
+			Q.erase(a); stdQ.erase(a);
+		}
+		if(Q.size() != stdQ.size()) return 0;
+	}
+	if(!same(Q, stdQ)) return 0;
+
+	int caught = 0;
+	M P;
+	P[1] = 1;
+	try { Q.insert(P.begin(), M::value_type(1, 1)); } catch(...) { caught++; }
+	try { Q.erase(P.begin(), Q.end()); } catch(...) { caught++; }
+	try { Q.erase(Q.end(), Q.begin()); } catch(...) { caught++; }
+	try { Q.erase(Q.lower_bound(30000), Q.lower_bound(20000)); } catch(...) { caught++; }
+	M::iterator mid = Q.lower_bound(20000), after = mid;
+	++after;
+	try { Q.erase(after, mid); } catch(...) { caught++; }
+	if(caught != 5 || !same(Q, stdQ)) return 0;
+
+	if(Q.erase(Q.begin(), Q.end()) != Q.end() || !Q.empty() || Q.begin() != Q.end()) return 0;
+	Q.insert(Q.end(), M::value_type(5, 5));
+	Q[3] = 3;
+	return Q.size() == 2 && Q.begin() -> first == 3;
+}
+
+int main(){
+	if(!check1()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check2()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check3()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check4()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	if(!check6()) cout << "Test 6 Failed......" << endl; else cout << "Test 6 Passed!" << endl;
+	if(!check7()) cout << "Test 7 Failed......" << endl; else cout << "Test 7 Passed!" << endl;
+	return 0;
+}
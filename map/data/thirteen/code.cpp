@@ -0,0 +1,154 @@
+#include<iostream>
+#include<map>
+#include<vector>
+#include<utility>
+#include<cstdio>
+#include<cstdlib>
+#include "map.hpp"
+
+using namespace std;
+
+unsigned int seed = 97531;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+template<class M, class S>
+bool same(M &Q, S &stdQ){
+	if(Q.size() != stdQ.size()) return 0;
+	typename M::iterator it = Q.begin();
+	for(typename S::iterator stdit = stdQ.begin(); stdit != stdQ.end(); ++it, ++stdit){
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	}
+	return it == Q.end();
+}
+
+//bulk builds of every size up to a few hundred, then set operations, against std::map
+template<class Balance>
+bool check(){
+	typedef sjtu::map<int, int, std::less<int>, Balance> M;
+	for(int n = 0; n < 300; n++){
+		std::vector<std::pair<int, int> > v;
+		std::map<int, int> stdQ;
+		for(int i = 0; i < n; i++){ v.push_back(std::make_pair(i * 2, i)); stdQ[i * 2] = i; }
+		M Q(sjtu::sorted_unique, v.begin(), v.end());
+		if(!same(Q, stdQ)) return 0;
+		M P(sjtu::sorted_unique, Q.begin(), Q.end());
+		if(!same(P, stdQ)) return 0;
+		for(int i = 0; i < 100; i++){
+			int a = randNum(2 * n + 10);
+			if(randNum(2)){ Q[a] = i; stdQ[a] = i; }
+			else if(Q.erase(a) != stdQ.erase(a)) return 0;
+		}
+		if(!same(Q, stdQ)) return 0;
+	}
+	for(int round = 0; round < 200; round++){
+		int range = 1 + randNum(5000), na = randNum(2000), nb = round % 3 == 0 ? randNum(10) : randNum(2000);
+		M A, B;
+		std::map<int, int> stdA, stdB;
+		for(int i = 0; i < na; i++){ int a = randNum(range); A[a] = i; stdA[a] = i; }
+		for(int i = 0; i < nb; i++){ int a = randNum(range); B[a] = -i; stdB[a] = -i; }
+		std::map<int, int> wantA = stdA, wantB = stdB;
+		if(round % 4 == 0){
+			A.merge(B);
+			for(std::map<int, int>::iterator it = stdB.begin(); it != stdB.end(); ++it)
+				if(!stdA.count(it -> first)){ wantA.insert(*it); wantB.erase(it -> first); }
+		}
+		else if(round % 4 == 1){
+			A.set_union(B);
+			for(std::map<int, int>::iterator it = stdB.begin(); it != stdB.end(); ++it) wantA.insert(*it);
+		}
+		else if(round % 4 == 2){
+			A.set_intersection(B);
+			for(std::map<int, int>::iterator it = stdA.begin(); it != stdA.end(); ++it)
+				if(!stdB.count(it -> first)) wantA.erase(it -> first);
+		}
+		else{
+			A.set_difference(B);
+			for(std::map<int, int>::iterator it = stdB.begin(); it != stdB.end(); ++it) wantA.erase(it -> first);
+		}
+		if(!same(A, wantA) || !same(B, wantB)) return 0;
+		for(int i = 0; i < 300; i++){
+			int a = randNum(range);
+			if(randNum(2)){ A[a] = i; wantA[a] = i; }
+			else if(A.erase(a) != wantA.erase(a)) return 0;
+		}
+		if(!same(A, wantA)) return 0;
+	}
+	return 1;
+}
+
+int alive = 0, budget = -1;
+struct Fragile{
+	int v;
+	Fragile(int v = 0) : v(v) { alive++; }
+	Fragile(const Fragile &other) : v(other.v) {
+		if(budget == 0) throw 1;
+		if(budget > 0) budget--;
+		alive++;
+	}
+	Fragile &operator=(const Fragile &other){ v = other.v; return *this; }
+	~Fragile(){ alive--; }
+};
+
+bool check5(){ //a copy throwing half way leaves no leak and a valid map
+	typedef sjtu::map<int, Fragile> M;
+	{
+		std::vector<std::pair<int, Fragile> > v;
+		for(int i = 0; i < 1000; i++) v.push_back(std::make_pair(i, Fragile(i)));
+		budget = 600;
+		bool thrown = 0;
+		try { M Q(sjtu::sorted_unique, v.begin(), v.end()); } catch(int) { thrown = 1; }
+		budget = -1;
+		if(!thrown || alive != 1000) return 0;
+
+		M A(sjtu::sorted_unique, v.begin(), v.begin() + 500), B;
+		for(int i = 0; i < 1000; i += 2) B[i].v = -i;
+		budget = 100;
+		thrown = 0;
+		try { A.set_union(B); } catch(int) { thrown = 1; }
+		budget = -1;
+		if(!thrown || A.size() != 600) return 0;
+		int last = -1;
+		for(M::iterator it = A.begin(); it != A.end(); ++it){
+			if(it -> first <= last) return 0;
+			if(it -> first < 500 && it -> second.v != it -> first) return 0;
+			last = it -> first;
+		}
+		A.set_union(B);
+		if(A.size() != 750) return 0;
+	}
+	return alive == 0;
+}
+
+bool check6(){ //a large sorted load and the order statistics on the built tree
+	std::vector<std::pair<int, long long> > v;
+	for(int i = 0; i < 1000000; i++) v.push_back(std::make_pair(i * 3, (long long)i));
+	sjtu::map<int, long long, std::less<int>, sjtu::avl_balance, sjtu::subtree_aggregate<long long> > Q(sjtu::sorted_unique, v.begin(), v.end());
+	if(Q.size() != 1000000 || Q.rank(3000) != 1000 || Q.select(999999) -> first != 2999997) return 0;
+	if(Q.aggregate_range(0, 30) != 45 || Q.count_range(-5, 3000000) != 1000000) return 0;
+	sjtu::map<int, long long, std::less<int>, sjtu::avl_balance, sjtu::subtree_aggregate<long long> > P;
+	for(int i = 0; i < 3000000; i += 2) P[i] = 1;
+	Q.set_intersection(P);
+	if(Q.size() != 500000 || Q.rank(6) != 1 || Q.aggregate_range(0, 13) != 0 + 2 + 4) return 0;
+	sjtu::map<int, long long, std::less<int>, sjtu::avl_balance, sjtu::subtree_aggregate<long long> > S;
+	for(int i = 0; i < 12; i++) S[i * 6 + randNum(6)] = 0;
+	S[6] = S[12] = S[600000] = 0;
+	size_t want = 0;
+	long long sum = 0;
+	for(sjtu::map<int, long long, std::less<int>, sjtu::avl_balance, sjtu::subtree_aggregate<long long> >::iterator it = S.begin(); it != S.end(); ++it)
+		if(Q.count(it -> first)){ want++; sum += Q.at(it -> first); }
+	Q.set_intersection(S);
+	return Q.size() == want && Q.rank(600000) == want - 1 && Q.aggregate_range(0, 600001) == sum && sum > 100000;
+}
+
+int main(){
+	if(!check<sjtu::avl_balance>()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check<sjtu::rb_balance>()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check<sjtu::treap_balance>()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check<sjtu::splay_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	if(!check6()) cout << "Test 6 Failed......" << endl; else cout << "Test 6 Passed!" << endl;
+	return 0;
+}
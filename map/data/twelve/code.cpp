@@ -0,0 +1,97 @@
+#include<iostream>
+#include<map>
+#include<cstdio>
+#include<cstdlib>
+#include<functional>
+#include "map.hpp"
+
+using namespace std;
+
+unsigned int seed = 1357911;
+int randNum(int n){
+	seed = seed * 1103515245u + 12345u;
+	return (int)((seed >> 1) % n);
+}
+
+struct summer{
+	long long sum;
+	int cnt, last;
+	bool sorted;
+	summer() : sum(0), cnt(0), last(-2147483647 - 1), sorted(1) {}
+	void operator()(const sjtu::pair<const int, int> &v){
+		if(v.first <= last) sorted = 0;
+		last = v.first;
+		sum += v.second;
+		cnt++;
+	}
+};
+
+//bounds against std::map, on keys present and absent and past both ends
+template<class Balance>
+bool check(){
+	typedef sjtu::map<int, int, std::less<int>, Balance> M;
+	M Q;
+	std::map<int, int> stdQ;
+	for(int i = 0; i < 50000; i++){
+		int a = randNum(200000);
+		Q[a] = i; stdQ[a] = i;
+	}
+	const M &C = Q;
+	for(int i = 0; i < 50000; i++){
+		int a = randNum(200100) - 50;
+		typename M::iterator l = Q.lower_bound(a), u = Q.upper_bound(a);
+		typename M::const_iterator cl = C.lower_bound(a), cu = C.upper_bound(a);
+		std::map<int, int>::iterator sl = stdQ.lower_bound(a), su = stdQ.upper_bound(a);
+		if((l == Q.end()) != (sl == stdQ.end()) || (u == Q.end()) != (su == stdQ.end())) return 0;
+		if(l != Q.end() && (l -> first != sl -> first || cl -> first != sl -> first)) return 0;
+		if(u != Q.end() && (u -> first != su -> first || cu -> first != su -> first)) return 0;
+		if(cl != l || cu != u) return 0;
+		sjtu::pair<typename M::iterator, typename M::iterator> e = Q.equal_range(a);
+		sjtu::pair<typename M::const_iterator, typename M::const_iterator> ce = C.equal_range(a);
+		if(e.first != l || e.second != u || ce.first != cl || ce.second != cu) return 0;
+	}
+	for(int i = 0; i < 2000; i++){
+		int lo = randNum(200100) - 50, hi = lo + randNum(2000) - 10;
+		summer s = Q.for_each_in_range(lo, hi, summer()), cs = C.for_each_in_range(lo, hi, summer());
+		long long sum = 0;
+		int cnt = 0;
+		for(std::map<int, int>::iterator it = stdQ.lower_bound(lo); it != stdQ.end() && it -> first < hi; ++it){
+			sum += it -> second;
+			cnt++;
+		}
+		if(s.sum != sum || s.cnt != cnt || !s.sorted || cs.sum != sum || cs.cnt != cnt) return 0;
+	}
+	//the values can be changed through the non-const walk
+	Q.for_each_in_range(1000, 2000, [](sjtu::pair<const int, int> &v){ v.second = -1; });
+	for(std::map<int, int>::iterator it = stdQ.lower_bound(1000); it != stdQ.end() && it -> first < 2000; ++it) it -> second = -1;
+	typename M::iterator it = Q.begin();
+	for(std::map<int, int>::iterator stdit = stdQ.begin(); stdit != stdQ.end(); ++it, ++stdit)
+		if(it -> first != stdit -> first || it -> second != stdit -> second) return 0;
+	return it == Q.end();
+}
+
+bool check5(){ //a reversed order, and an empty map
+	sjtu::map<int, int, std::greater<int> > Q;
+	if(Q.lower_bound(1) != Q.end() || Q.upper_bound(1) != Q.end()) return 0;
+	if(Q.equal_range(1).first != Q.end() || Q.for_each_in_range(10, 0, summer()).cnt != 0) return 0;
+	for(int i = 0; i < 100; i += 2) Q[i] = i;
+	if(Q.lower_bound(51) -> first != 50 || Q.upper_bound(50) -> first != 48) return 0;
+	if(Q.lower_bound(-1) != Q.end() || Q.upper_bound(0) != Q.end() || Q.lower_bound(1000) != Q.begin()) return 0;
+	typedef sjtu::map<int, int, std::greater<int> >::iterator iter;
+	sjtu::pair<iter, iter> e = Q.equal_range(98), f = Q.equal_range(97);
+	if(e.first != Q.begin() || e.second -> first != 96) return 0;
+	if(f.first != f.second || f.first -> first != 96) return 0;
+	int cnt = 0, last = 1000;
+	bool ok = 1;
+	Q.for_each_in_range(60, 40, [&](const sjtu::pair<const int, int> &v){ if(v.first >= last) ok = 0; last = v.first; cnt++; });
+	return ok && cnt == 10 && last == 42;
+}
+
+int main(){
+	if(!check<sjtu::avl_balance>()) cout << "Test 1 Failed......" << endl; else cout << "Test 1 Passed!" << endl;
+	if(!check<sjtu::rb_balance>()) cout << "Test 2 Failed......" << endl; else cout << "Test 2 Passed!" << endl;
+	if(!check<sjtu::treap_balance>()) cout << "Test 3 Failed......" << endl; else cout << "Test 3 Passed!" << endl;
+	if(!check<sjtu::splay_balance>()) cout << "Test 4 Failed......" << endl; else cout << "Test 4 Passed!" << endl;
+	if(!check5()) cout << "Test 5 Failed......" << endl; else cout << "Test 5 Passed!" << endl;
+	return 0;
+}
@@ -7,16 +7,32 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <utility>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "tree.hpp"
 
 namespace sjtu {
 
+/**
+ * tells a constructor that its range is sorted already and holds no equal keys.
+ */
+struct sorted_unique_t {};
+const sorted_unique_t sorted_unique = sorted_unique_t();
+
+/**
+ * Balance picks how the tree is kept shallow, see tree.hpp:
+ * avl_balance (the default), rb_balance, treap_balance or splay_balance.
+ * Augment is what every node knows about its subtree: no_augment (the default),
+ * subtree_size for rank() and select(), or subtree_aggregate<T, Op> for aggregate_range() as well.
+ */
 template<
 	class Key,
 	class T,
-	class Compare = std::less<Key>
-> class map {
+	class Compare = std::less<Key>,
+	class Balance = avl_balance,
+	class Augment = no_augment
+> class map : private tree_core<tree_node<pair<const Key, T>, Augment> > {
     friend class iterator;
     friend class const_iterator;
 public:
@@ -36,186 +52,314 @@ public:
 private:
     Compare cmp;
 
-    struct node{
-        value_type *data;
-        node *father;
-        node *lc, *rc;
+    typedef tree_node<value_type, Augment> node;
+    typedef tree_core<node> core;
 
-        node(value_type *v = NULL) : data(v) {
-            father = lc = rc = NULL;
-        }
-        ~node() {
-            if (data != NULL)
-                delete data;
-        }
-    };
+    using core::root;
+    using core::leftmost;
+    using core::rightmost;
+    using core::reset;
+    using core::prev;
+    using core::next;
+    using core::makeEmpty;
+    using core::copy;
+    using core::pullUp;
 
-    node *root;
     size_t _size;
 
-    bool islc(node *t) const {
-        if (t == root)
-            return false;
-        return t->father->lc == t;
+    core &tree() {
+        return *this;
     }
 
-    node *prev(node *t) const{
-        if (t->lc != NULL) {
-            t = t->lc;
-            while (t->rc != NULL) {
+    /**
+     * the node holding key, or NULL.
+     */
+    node *locate(const Key &key) const {
+        node *t = root;
+        while (t != NULL) {
+            if (cmp(key, t->data.first))
+                t = t->lc;
+            else if (cmp(t->data.first, key))
                 t = t->rc;
-            }
-            return t;
-        }
-        else {
-            while (islc(t) && t != root) {
-                t = t->father;
-            }
-            return t->father;
+            else
+                return t;
         }
+        return NULL;
     }
 
-    node *next(node *t) const{
-        if (t->rc != NULL) {
-            t = t->rc;
-            while (t->lc != NULL) {
+    /**
+     * the node holding key, or NULL; in that case a node for key belongs below fa,
+     * on the left if left (fa == NULL when the map is empty).
+     */
+    node *descend(const Key &key, node *&fa, bool &left) const {
+        node *t = root;
+        fa = NULL;
+        left = false;
+        while (t != NULL) {
+            if (cmp(key, t->data.first)) {
+                fa = t;
                 t = t->lc;
+                left = true;
             }
-            return t;
-        }
-        else {
-            while (!islc(t) && t != root) {
-                t = t->father;
+            else if (cmp(t->data.first, key)) {
+                fa = t;
+                t = t->rc;
+                left = false;
             }
-            return t->father;
+            else
+                return t;
         }
+        return NULL;
     }
 
-    node *insert(const value_type &x, node *&t, node *fa) {
-        node *ret;
-        if (t == NULL) {
-            t = new node(new value_type(x));
-            t->father = fa;
-            return t;
-        }
-        else if (cmp(x.first, t->data->first)) {
-            ret = insert(x, t->lc, t);
-        }
-        else if (cmp(t->data->first, x.first)) {
-            ret = insert(x, t->rc, t);
-        }
-
-        return ret;
+    /**
+     * links the new leaf t below fa and lets the policy rebalance.
+     */
+    node *attach(node *t, node *fa, bool left) {
+        core::link(t, fa, left);
+        ++_size;
+        Balance::inserted(tree(), t);
+        return t;
     }
 
-    void swap(node *&x, node *&y) {
-        node tx = *x, ty = *y;
-        tx.data = ty.data = NULL;
+    /**
+     * where a node for key goes when it belongs right next to hint, as in std::map.
+     * returns false when the hint is wrong; found is set when hint holds key itself.
+     */
+    bool near(node *hint, const Key &key, node *&fa, bool &left, bool &found) const {
+        found = false;
+        if (hint == NULL) {
+            if (rightmost != NULL && cmp(rightmost->data.first, key)) {
+                fa = rightmost;
+                left = false;
+                return true;
+            }
+            return false;
+        }
 
-        if (x == y->father) {
-            x->father = y;
-            if (y == tx.lc) {
-                y->lc = x;
-                y->rc = tx.rc;
+        if (cmp(key, hint->data.first)) {
+            if (hint == leftmost) {
+                fa = hint;
+                left = true;
+                return true;
+            }
+            node *before = prev(hint);
+            if (!cmp(before->data.first, key))
+                return false;
+            if (before->rc == NULL) {
+                fa = before;
+                left = false;
             }
             else {
-                y->rc = x;
-                y->lc = tx.lc;
+                fa = hint;
+                left = true;
             }
+            return true;
         }
-        else {
-            x->father = ty.father;
-            if (y == y->father->lc) {
-                y->father->lc = x;
+
+        if (cmp(hint->data.first, key)) {
+            if (hint == rightmost) {
+                fa = hint;
+                left = false;
+                return true;
+            }
+            node *after = next(hint);
+            if (!cmp(key, after->data.first))
+                return false;
+            if (hint->rc == NULL) {
+                fa = hint;
+                left = false;
             }
             else {
-                y->father->rc = x;
+                fa = after;
+                left = true;
             }
-            y->lc = tx.lc;
-            y->rc = tx.rc;
+            return true;
         }
-        x->lc = ty.lc;
-        x->rc = ty.rc;
-        y->father = tx.father;
-
-        if (x->lc) x->lc->father = x;
-        if (x->rc) x->rc->father = x;
-        if (y->lc) y->lc->father = y;
-        if (y->rc) y->rc->father = y;
-
-        node *t;
-        t = x;
-        x = y;
-        y = t;
+
+        found = true;
+        return true;
     }
 
-    void remove(const Key &key, node *&t) {
-        if (t == NULL)
-            return;
+    /**
+     * nodes linked through rc in order, as flatten() leaves them and rebuild() takes them.
+     */
+    struct chain {
+        node *head, *tail;
+        size_t n;
 
-        if (cmp(key, t->data->first)) {
-            remove(key, t->lc);
-        }
-        else if (cmp(t->data->first, key)) {
-            remove(key, t->rc);
+        chain() : head(NULL), tail(NULL), n(0) {}
+
+        void push(node *t) {
+            t->rc = NULL;
+            if (tail == NULL)
+                head = t;
+            else
+                tail->rc = t;
+            tail = t;
+            ++n;
         }
-        else if (t->lc != NULL && t->rc != NULL) {
-//            node *tmp = t->rc;
-//            while (tmp->lc != NULL) {
-//                tmp = tmp->lc;
-//            }
-//            if (t->data != NULL)
-//                delete t->data;
-//            t->data = new value_type(*(tmp->data));
-//            remove(tmp->data->first, t->rc);
-
-            node *tmp = t->lc;
-            while (tmp->rc != NULL) {
-                tmp = tmp->rc;
+
+        /**
+         * pushes x and every node after it.
+         */
+        void splice(node *x) {
+            while (x != NULL) {
+                node *nx = x->rc;
+                push(x);
+                x = nx;
             }
-//            if (t->data != NULL)
-//                delete t->data;
-//            t->data = new value_type(*(tmp->data));
-            swap(t, tmp);
-            remove(tmp->data->first, t->lc);
         }
-        else {
-            node *oldNode = t;
-            if (t->lc != NULL)
-                t = t->lc;
-            else
-                t = t->rc;
+    };
 
-            if (t != NULL) {
-                t->father = oldNode->father;
-            }
-            oldNode->lc = oldNode->rc = NULL;
-            if (oldNode)
-                delete oldNode;
+    /**
+     * takes all the nodes out of the tree, in order, and leaves the map empty. O(n).
+     * going back from the last node only ever reads the rc of nodes not taken yet.
+     */
+    chain flatten() {
+        chain c;
+        for (node *t = rightmost; t != NULL; ) {
+            node *p = prev(t);
+            t->rc = c.head;
+            c.head = t;
+            if (c.tail == NULL)
+                c.tail = t;
+            ++c.n;
+            t = p;
         }
+        reset();
+        _size = 0;
+        return c;
+    }
 
+    /**
+     * makes the nodes of c the contents, as a perfectly balanced tree. O(n).
+     */
+    void rebuild(const chain &c) {
+        node *t = c.head;
+        reset(core::template build<Balance>(c.n, [&t]() {
+            node *ret = t;
+            t = t->rc;
+            return ret;
+        }));
+        _size = c.n;
     }
 
-    node *find(const Key &key, node *t) const {
-        if (t == NULL)
-            return t;
-        if (!(cmp(key, t->data->first) || cmp(t->data->first, key)))
-            return t;
+    /**
+     * whether m descents into this map cost less than a walk over all of it.
+     */
+    bool few(size_t m) const {
+        return m * core::levels(_size) < _size;
+    }
 
-        if (cmp(key, t->data->first))
-            return find(key, t->lc);
-        else
-            return find(key, t->rc);
+    /**
+     * walks this map and other together in key order, and rebuilds this map from its elements
+     * whose keys are only in this (if onlyThis) or in both (if both), plus copies of the elements
+     * whose keys are only in other (if onlyOther); the rest of this map is deleted. O(n + m).
+     * if a copy throws, the elements kept or copied so far and the ones not reached yet are left.
+     */
+    void meld(const map &other, bool onlyThis, bool both, bool onlyOther) {
+        chain r;
+        node *x = flatten().head, *y = other.leftmost;
+        try {
+            while (x != NULL && y != NULL) {
+                if (cmp(y->data.first, x->data.first)) {
+                    if (onlyOther)
+                        r.push(new node(y->data));
+                    y = other.next(y);
+                    continue;
+                }
+                bool keep = onlyThis;
+                if (!cmp(x->data.first, y->data.first)) {
+                    keep = both;
+                    y = other.next(y);
+                }
+                node *nx = x->rc;
+                if (keep)
+                    r.push(x);
+                else
+                    delete x;
+                x = nx;
+            }
+            for (; onlyOther && y != NULL; y = other.next(y))
+                r.push(new node(y->data));
+        }
+        catch (...) {
+            r.splice(x);
+            rebuild(r);
+            throw;
+        }
+
+        if (onlyThis) {
+            r.splice(x);
+        }
+        else {
+            while (x != NULL) {
+                node *nx = x->rc;
+                delete x;
+                x = nx;
+            }
+        }
+        rebuild(r);
     }
 
-    void makeEmpty(node *t) {
-        if (t == NULL)
-            return;
+    /**
+     * the first node with a key not less than key (lower) or greater than key (upper), or NULL.
+     */
+    node *lowerNode(const Key &key) const {
+        node *t = root, *ret = NULL;
+        while (t != NULL) {
+            if (cmp(t->data.first, key))
+                t = t->rc;
+            else {
+                ret = t;
+                t = t->lc;
+            }
+        }
+        return ret;
+    }
 
-        makeEmpty(t->lc);
-        makeEmpty(t->rc);
+    node *upperNode(const Key &key) const {
+        node *t = root, *ret = NULL;
+        while (t != NULL) {
+            if (cmp(key, t->data.first)) {
+                ret = t;
+                t = t->lc;
+            }
+            else
+                t = t->rc;
+        }
+        return ret;
+    }
 
-        delete t;
+    /**
+     * the node with k nodes before it, by the subtree sizes.
+     */
+    node *nth(size_t k) const {
+        if (k >= _size)
+            throw index_out_of_bound();
+        node *t = root;
+        while (true) {
+            size_t l = node::sizeOf(t->lc);
+            if (k < l)
+                t = t->lc;
+            else if (k == l)
+                return t;
+            else {
+                k -= l + 1;
+                t = t->rc;
+            }
+        }
+    }
+
+    /**
+     * the node holding key, or NULL; the policy is told about the lookup.
+     */
+    node *lookup(const Key &key) {
+        node *t = locate(key);
+        if (t != NULL)
+            Balance::accessed(tree(), t);
+        return t;
     }
 
 public:
@@ -273,10 +417,7 @@ public:
 
             iterator ret = *this;
             if (*this == mp->end()) {
-                nod = mp->root;
-                while (nod->rc != NULL) {
-                    nod = nod->rc;
-                }
+                nod = mp->rightmost;
             }
             else {
                 nod = mp->prev(nod);
@@ -292,10 +433,7 @@ public:
                 throw invalid_iterator();
 
             if (*this == mp->end()) {
-                nod = mp->root;
-                while (nod->rc != NULL) {
-                    nod = nod->rc;
-                }
+                nod = mp->rightmost;
             } else {
                 nod = mp->prev(nod);
             }
@@ -306,9 +444,9 @@ public:
 		 * a operator to check whether two iterators are same (pointing to the same memory).
 		 */
 		value_type & operator*() const {
-            if (nod == NULL || nod->data == NULL)
+            if (nod == NULL)
                 throw invalid_iterator();
-		    return *(nod->data);
+		    return nod->data;
 		}
 		bool operator==(const iterator &rhs) const {
 		    return mp == rhs.mp && nod == rhs.nod;
@@ -331,7 +469,7 @@ public:
 		 * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
 		 */
 		value_type* operator->() const noexcept {
-		    return nod->data;
+		    return &nod->data;
 		}
 	};
 	class const_iterator {
@@ -385,10 +523,7 @@ public:
 
             const_iterator ret = *this;
             if (*this == mp->cend()) {
-                nod = mp->root;
-                while (nod->rc != NULL) {
-                    nod = nod->rc;
-                }
+                nod = mp->rightmost;
             }
             else {
                 nod = mp->prev(nod);
@@ -404,10 +539,7 @@ public:
                 throw invalid_iterator();
 
             if (*this == mp->cend()) {
-                nod = mp->root;
-                while (nod->rc != NULL) {
-                    nod = nod->rc;
-                }
+                nod = mp->rightmost;
             }
             else {
                 nod = mp->prev(nod);
@@ -419,9 +551,9 @@ public:
          * a operator to check whether two iterators are same (pointing to the same memory).
          */
         const value_type & operator*() const {
-            if (nod == NULL || nod->data == NULL)
+            if (nod == NULL)
                 throw invalid_iterator();
-            return *(nod->data);
+            return nod->data;
         }
         bool operator==(const iterator &rhs) const {
             return mp == rhs.mp && nod == rhs.nod;
@@ -444,24 +576,10 @@ public:
          * See <http://kelvinh.github.io/blog/2013/11/20/overloading-of-member-access-operator-dash-greater-than-symbol-in-cpp/> for help.
          */
         const value_type* operator->() const noexcept {
-            return nod->data;
+            return &nod->data;
         }
 	};
 
-private:
-    void copy(node *&t, node *other, node *fa) {
-        if (other == NULL)
-            return;
-
-        t = new node(new value_type(*(other->data)));
-        t->father = fa;
-
-        if (other->lc)
-            copy(t->lc, other->lc, t);
-        if (other->rc)
-            copy(t->rc, other->rc, t);
-    }
-
 public:
 	/**
 	 * TODO two constructors
@@ -471,10 +589,26 @@ public:
 	    _size = 0;
 	}
 	map(const map &other) {
-	    root = NULL;
-	    copy(root, other.root, NULL);
+	    reset(copy(other.root));
 	    _size = other._size;
 	}
+	/**
+	 * the map of [first, last), which must be sorted by Compare with no equal keys;
+	 * the elements may be sjtu::pair or std::pair.
+	 * O(n) with no comparison and no rotation, and the tree comes out perfectly balanced.
+	 */
+	template<class ForwardIt>
+	map(sorted_unique_t, ForwardIt first, ForwardIt last) {
+	    size_t n = 0;
+	    for (ForwardIt it = first; it != last; ++it)
+	        ++n;
+	    reset(core::template build<Balance>(n, [&first]() {
+	        node *t = new node(first->first, first->second);
+	        ++first;
+	        return t;
+	    }));
+	    _size = n;
+	}
 	/**
 	 * TODO assignment operator
 	 */
@@ -483,7 +617,7 @@ public:
             return *this;
 
 	    clear();
-	    copy(root, other.root, NULL);
+	    reset(copy(other.root));
 	    _size = other._size;
         return *this;
 	}
@@ -500,16 +634,16 @@ public:
 	 * If no such element exists, an exception of type `index_out_of_bound'
 	 */
 	T & at(const Key &key) {
-        node *t = find(key, root);
+        node *t = lookup(key);
         if (t == NULL)
             throw index_out_of_bound();
-        return t->data->second;
+        return t->data.second;
 	}
 	const T & at(const Key &key) const {
-        node *t = find(key, root);
+        node *t = locate(key);
         if (t == NULL)
             throw index_out_of_bound();
-        return t->data->second;
+        return t->data.second;
 	}
 	/**
 	 * TODO
@@ -518,14 +652,7 @@ public:
 	 *   performing an insertion if such key does not already exist.
 	 */
 	T & operator[](const Key &key) {
-	    node *tmp = find(key, root);
-
-        if (tmp == NULL) {
-            ++_size;
-            tmp = insert(value_type(key, T()), root, NULL);
-        }
-
-        return tmp->data->second;
+        return try_emplace(key).first->second;
 	}
 	/**
 	 * behave like at() throw index_out_of_bound if such key does not exist.
@@ -537,22 +664,10 @@ public:
 	 * return a iterator to the beginning
 	 */
 	iterator begin() {
-        node *tmp = root;
-        if (tmp == NULL)
-            return iterator(this, NULL);
-        while (tmp->lc != NULL) {
-            tmp = tmp->lc;
-        }
-	    return iterator(this, tmp);
+	    return iterator(this, leftmost);
 	}
 	const_iterator cbegin() const {
-        node *tmp = root;
-        if (tmp == NULL)
-            return const_iterator(this, NULL);
-        while (tmp->lc != NULL) {
-            tmp = tmp->lc;
-        }
-        return const_iterator(this, tmp);
+        return const_iterator(this, leftmost);
 	}
 	/**
 	 * return a iterator to the end
@@ -584,7 +699,7 @@ public:
 	void clear() {
 	    _size = 0;
 	    makeEmpty(root);
-	    root = NULL;
+	    reset();
 	}
 	/**
 	 * insert an element.
@@ -593,32 +708,245 @@ public:
 	 *   the second one is true if insert successfully, or false.
 	 */
 	pair<iterator, bool> insert(const value_type &value) {
-	    node *tmp = find(value.first, root);
+	    node *fa;
+	    bool left;
+	    node *tmp = descend(value.first, fa, left);
 
-	    if (tmp == NULL) {
-	        ++_size;
-	        node *t = insert(value, root, NULL);
-	        return pair<iterator, bool>(iterator(this, t), true);
+	    if (tmp != NULL) {
+	        Balance::accessed(tree(), tmp);
+	        return pair<iterator, bool>(iterator(this, tmp), false);
 	    }
-	    else
+	    return pair<iterator, bool>(iterator(this, attach(new node(value), fa, left)), true);
+	}
+	/**
+	 * insert with a hint: value is expected to go just before hint (end() to append).
+	 * then no descent is made and the insert is amortized O(1), otherwise it falls back to insert(value).
+	 * returns the iterator to the new element or to the one that prevented the insertion.
+	 * throw invalid_iterator if hint points to another map.
+	 */
+	iterator insert(iterator hint, const value_type &value) {
+	    if (hint.mp != this)
+	        throw invalid_iterator();
+
+	    node *fa;
+	    bool left, found;
+	    if (!near(hint.nod, value.first, fa, left, found))
+	        return insert(value).first;
+	    if (found)
+	        return hint;
+	    return iterator(this, attach(new node(value), fa, left));
+	}
+	/**
+	 * inserts (key, T(args...)) if key is absent, in a single descent.
+	 * if key is present nothing is constructed, and args are left untouched.
+	 * return like insert(value).
+	 */
+	template<class... Args>
+	pair<iterator, bool> try_emplace(const Key &key, Args&&... args) {
+	    node *fa;
+	    bool left;
+	    node *tmp = descend(key, fa, left);
+
+	    if (tmp != NULL) {
+	        Balance::accessed(tree(), tmp);
+	        return pair<iterator, bool>(iterator(this, tmp), false);
+	    }
+	    tmp = new node(key, T(std::forward<Args>(args)...));
+	    return pair<iterator, bool>(iterator(this, attach(tmp, fa, left)), true);
+	}
+	/**
+	 * assigns obj to the element with key, or inserts (key, obj), in a single descent.
+	 * the second one of the result is true if it was inserted.
+	 */
+	template<class M>
+	pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+	    node *fa;
+	    bool left;
+	    node *tmp = descend(key, fa, left);
+
+	    if (tmp != NULL) {
+	        Balance::accessed(tree(), tmp);
+	        tmp->data.second = std::forward<M>(obj);
+	        pullUp(tmp);
 	        return pair<iterator, bool>(iterator(this, tmp), false);
+	    }
+	    tmp = new node(key, std::forward<M>(obj));
+	    return pair<iterator, bool>(iterator(this, attach(tmp, fa, left)), true);
 	}
 	/**
 	 * erase the element at pos.
+	 * the node is unlinked through its father links, no key is compared.
+	 * returns the iterator to the element after it.
 	 *
 	 * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
 	 */
-	void erase(iterator pos) {
+	iterator erase(iterator pos) {
 	    if (pos == end() || pos.mp != this)
 	        throw invalid_iterator();
 
-//	    Key key = pos->first;
-	    if (find(pos->first, root) == NULL)
-            throw invalid_iterator();
+	    node *nx = next(pos.nod);
+	    Balance::erase(tree(), pos.nod);
+	    delete pos.nod;
+	    --_size;
+	    return iterator(this, nx);
+	}
+	/**
+	 * erase the elements in [first, last), O(k + log n) for k elements; the whole map is simply cleared.
+	 * returns last.
+	 *
+	 * throw invalid_iterator if first or last points out of this, or last is not reached from first.
+	 */
+	iterator erase(iterator first, iterator last) {
+	    if (first.mp != this || last.mp != this)
+	        throw invalid_iterator();
+	    // checked by key order before anything is erased
+	    if (last.nod != NULL && (first.nod == NULL || cmp(last.nod->data.first, first.nod->data.first)))
+	        throw invalid_iterator();
 
+	    if (first.nod == leftmost && last.nod == NULL) {
+	        clear();
+	        return end();
+	    }
+	    while (first != last)
+	        first = erase(first);
+	    return last;
+	}
+	/**
+	 * erase the element with key if there is one, returns the number erased (0 or 1).
+	 */
+	size_t erase(const Key &key) {
+	    node *t = locate(key);
+	    if (t == NULL)
+	        return 0;
+	    erase(iterator(this, t));
+	    return 1;
+	}
+	/**
+	 * moves into this map the elements of other whose keys it does not have, as std::map::merge;
+	 * the rest stay in other. nodes are relinked, nothing is copied and references to the elements stay valid.
+	 * O(n + m) by rebuilding both trees, or O(m log n) when other is much smaller.
+	 */
+	void merge(map &other) {
+	    if (&other == this)
+	        return;
 
-	    remove(pos->first, root);
-	    --_size;
+	    if (few(other._size)) {
+	        for (node *b = other.leftmost; b != NULL; ) {
+	            node *nb = other.next(b), *fa;
+	            bool left;
+	            if (descend(b->data.first, fa, left) == NULL) {
+	                Balance::erase(other.tree(), b);
+	                --other._size;
+	                attach(b, fa, left);
+	            }
+	            b = nb;
+	        }
+	        return;
+	    }
+
+	    chain r, rest;
+	    node *x = flatten().head, *y = other.flatten().head;
+	    try {
+	        while (x != NULL && y != NULL) {
+	            if (cmp(y->data.first, x->data.first)) {
+	                node *ny = y->rc;
+	                r.push(y);
+	                y = ny;
+	                continue;
+	            }
+	            if (!cmp(x->data.first, y->data.first)) {
+	                node *ny = y->rc;
+	                rest.push(y);
+	                y = ny;
+	            }
+	            node *nx = x->rc;
+	            r.push(x);
+	            x = nx;
+	        }
+	    }
+	    catch (...) {
+	        r.splice(x);
+	        rest.splice(y);
+	        rebuild(r);
+	        other.rebuild(rest);
+	        throw;
+	    }
+	    r.splice(x);
+	    r.splice(y);
+	    rebuild(r);
+	    other.rebuild(rest);
+	}
+	/**
+	 * the set operations keep the result in this map; for a key in both maps this map's value is kept.
+	 * each walks both maps once and rebuilds the tree, O(n + m),
+	 * except that a much smaller other is looked up key by key, O(m log n) comparisons:
+	 * set_union and set_difference then insert or erase only those keys,
+	 * set_intersection rebuilds from the hits (it still frees the other nodes).
+	 * set_union: adds copies of the elements of other whose keys are not in this map.
+	 */
+	void set_union(const map &other) {
+	    if (&other == this)
+	        return;
+	    if (few(other._size)) {
+	        for (node *b = other.leftmost; b != NULL; b = other.next(b))
+	            insert(b->data);
+	        return;
+	    }
+	    meld(other, true, true, true);
+	}
+	/**
+	 * erases the elements whose keys are not in other.
+	 */
+	void set_intersection(const map &other) {
+	    if (&other == this)
+	        return;
+	    if (few(other._size)) {
+	        // the hits come in key order; nothing is changed until all of them are found
+	        node **hit = new node *[other._size];
+	        size_t m = 0;
+	        try {
+	            for (node *b = other.leftmost; b != NULL; b = other.next(b)) {
+	                node *t = locate(b->data.first);
+	                if (t != NULL)
+	                    hit[m++] = t;
+	            }
+	        }
+	        catch (...) {
+	            delete[] hit;
+	            throw;
+	        }
+	        chain r;
+	        size_t j = 0;
+	        for (node *x = flatten().head; x != NULL; ) {
+	            node *nx = x->rc;
+	            if (j < m && x == hit[j]) {
+	                r.push(x);
+	                ++j;
+	            }
+	            else
+	                delete x;
+	            x = nx;
+	        }
+	        delete[] hit;
+	        rebuild(r);
+	        return;
+	    }
+	    meld(other, false, true, false);
+	}
+	/**
+	 * erases the elements whose keys are in other.
+	 */
+	void set_difference(const map &other) {
+	    if (&other == this) {
+	        clear();
+	        return;
+	    }
+	    if (few(other._size)) {
+	        for (node *b = other.leftmost; b != NULL; b = other.next(b))
+	            erase(b->data.first);
+	        return;
+	    }
+	    meld(other, true, false, false);
 	}
 	/**
 	 * Returns the number of elements with key 
@@ -628,7 +956,7 @@ public:
 	 * The default method of check the equivalence is !(a < b || b > a)
 	 */
 	size_t count(const Key &key) const {
-	    if (find(key, root) == NULL)
+	    if (locate(key) == NULL)
 	        return 0;
 	    else
 	        return 1;
@@ -640,7 +968,7 @@ public:
 	 *   If no such element is found, past-the-end (see end()) iterator is returned.
 	 */
 	iterator find(const Key &key) {
-	    node *tmp = find(key, root);
+	    node *tmp = lookup(key);
 
 	    if (tmp == NULL)
 	        return end();
@@ -648,13 +976,158 @@ public:
 	        return iterator(this, tmp);
 	}
 	const_iterator find(const Key &key) const {
-        node *tmp = find(key, root);
+        node *tmp = locate(key);
 
         if (tmp == NULL)
             return cend();
         else
             return const_iterator(this, tmp);
 	}
+	/**
+	 * the first element with a key not less than key, or end().
+	 */
+	iterator lower_bound(const Key &key) {
+	    node *t = lowerNode(key);
+	    if (t != NULL)
+	        Balance::accessed(tree(), t);
+	    return iterator(this, t);
+	}
+	const_iterator lower_bound(const Key &key) const {
+	    return const_iterator(this, lowerNode(key));
+	}
+	/**
+	 * the first element with a key greater than key, or end().
+	 */
+	iterator upper_bound(const Key &key) {
+	    node *t = upperNode(key);
+	    if (t != NULL)
+	        Balance::accessed(tree(), t);
+	    return iterator(this, t);
+	}
+	const_iterator upper_bound(const Key &key) const {
+	    return const_iterator(this, upperNode(key));
+	}
+	/**
+	 * the elements with key, as [lower_bound(key), upper_bound(key)): empty or just one.
+	 */
+	pair<iterator, iterator> equal_range(const Key &key) {
+	    iterator first = lower_bound(key);
+	    if (first.nod == NULL || cmp(key, first.nod->data.first))
+	        return pair<iterator, iterator>(first, first);
+	    return pair<iterator, iterator>(first, iterator(this, next(first.nod)));
+	}
+	pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+	    const_iterator first = lower_bound(key);
+	    if (first.nod == NULL || cmp(key, first.nod->data.first))
+	        return pair<const_iterator, const_iterator>(first, first);
+	    return pair<const_iterator, const_iterator>(first, const_iterator(this, next(first.nod)));
+	}
+	/**
+	 * calls fn(value) for every element with a key in [lo, hi), in key order, and returns fn.
+	 * one descent and then in-order steps between nodes, O(log n + k) for k elements.
+	 * fn must not insert into or erase from the map.
+	 */
+	template<class Fn>
+	Fn for_each_in_range(const Key &lo, const Key &hi, Fn fn) {
+	    for (node *t = lowerNode(lo); t != NULL && cmp(t->data.first, hi); t = next(t))
+	        fn(t->data);
+	    return fn;
+	}
+	template<class Fn>
+	Fn for_each_in_range(const Key &lo, const Key &hi, Fn fn) const {
+	    for (node *t = lowerNode(lo); t != NULL && cmp(t->data.first, hi); t = next(t))
+	        fn(const_cast<const value_type &>(t->data));
+	    return fn;
+	}
+	/**
+	 * the number of elements with a key less than key, whether key is there or not.
+	 * this and the queries below need an Augment with the subtree size (subtree_size or subtree_aggregate);
+	 * each walks one or two root paths, so O(log n), amortized with splay_balance.
+	 */
+	size_t rank(const Key &key) const {
+	    size_t r = 0;
+	    node *t = root;
+	    while (t != NULL) {
+	        if (cmp(t->data.first, key)) {
+	            r += node::sizeOf(t->lc) + 1;
+	            t = t->rc;
+	        }
+	        else
+	            t = t->lc;
+	    }
+	    return r;
+	}
+	/**
+	 * the element with k elements before it, i.e. std::next(begin(), k).
+	 * throw index_out_of_bound if k >= size().
+	 */
+	iterator select(size_t k) {
+	    node *t = nth(k);
+	    Balance::accessed(tree(), t);
+	    return iterator(this, t);
+	}
+	const_iterator select(size_t k) const {
+	    return const_iterator(this, nth(k));
+	}
+	/**
+	 * the number of elements with a key in [lo, hi).
+	 */
+	size_t count_range(const Key &lo, const Key &hi) const {
+	    if (!cmp(lo, hi))
+	        return 0;
+	    return rank(hi) - rank(lo);
+	}
+	/**
+	 * op over the mapped values with a key in [lo, hi), in key order; needs subtree_aggregate.
+	 * throw container_is_empty if there are none, as op may have no identity.
+	 */
+	T aggregate_range(const Key &lo, const Key &hi) const {
+	    node *t = root;
+	    while (t != NULL) {
+	        if (cmp(t->data.first, lo))
+	            t = t->rc;
+	        else if (!cmp(t->data.first, hi))
+	            t = t->lc;
+	        else
+	            break;
+	    }
+	    if (t == NULL)
+	        throw container_is_empty();
+
+	    // t is the highest node in range; what is in range below it hangs off two paths
+	    T acc = t->data.second;
+	    for (node *s = t->lc; s != NULL; ) {
+	        if (cmp(s->data.first, lo))
+	            s = s->rc;
+	        else {
+	            if (s->rc != NULL)
+	                acc = Augment::combine(s->rc->total, acc);
+	            acc = Augment::combine(s->data.second, acc);
+	            s = s->lc;
+	        }
+	    }
+	    for (node *s = t->rc; s != NULL; ) {
+	        if (!cmp(s->data.first, hi))
+	            s = s->lc;
+	        else {
+	            if (s->lc != NULL)
+	                acc = Augment::combine(acc, s->lc->total);
+	            acc = Augment::combine(acc, s->data.second);
+	            s = s->rc;
+	        }
+	    }
+	    return acc;
+	}
+	/**
+	 * recomputes the subtree information above pos after its value was changed in place,
+	 * through operator[], at() or an iterator; insert_or_assign() does it by itself.
+	 * throw invalid_iterator if pos is end() or points out of this.
+	 */
+	void refresh(iterator pos) {
+	    if (pos == end() || pos.mp != this)
+	        throw invalid_iterator();
+	    pullUp(pos.nod);
+	}
 };
 
 }
@@ -0,0 +1,775 @@
+#ifndef SJTU_TREE_HPP
+#define SJTU_TREE_HPP
+
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * subtree information a node can carry, as a base of tree_node.
+ * pull(t) recomputes it from t's own value and t's children; tree_core calls it
+ * after every rotation and on the path to the root after link() and unlink(),
+ * so the balancing policies keep it right without knowing about it.
+ */
+struct no_augment {
+    enum { augmented = 0 };
+
+    template<class Node>
+    static void pull(Node *) {}
+};
+
+/**
+ * the number of nodes in the subtree, which gives rank and select in O(height).
+ */
+struct subtree_size {
+    enum { augmented = 1 };
+
+    size_t size;
+
+    template<class Node>
+    static size_t sizeOf(const Node *t) {
+        return t == NULL ? 0 : t->size;
+    }
+
+    template<class Node>
+    static void pull(Node *t) {
+        t->size = sizeOf(t->lc) + sizeOf(t->rc) + 1;
+    }
+};
+
+/**
+ * the subtree size and op over the mapped values (data.second) of the subtree, in key order.
+ * op must be associative, it need not be commutative nor have an identity.
+ */
+template<class T, class Op = std::plus<T> >
+struct subtree_aggregate : subtree_size {
+    T total;
+
+    static T combine(const T &a, const T &b) {
+        return Op()(a, b);
+    }
+
+    template<class Node>
+    static void pull(Node *t) {
+        subtree_size::pull(t);
+        t->total = t->data.second;
+        if (t->lc != NULL)
+            t->total = combine(t->lc->total, t->total);
+        if (t->rc != NULL)
+            t->total = combine(t->total, t->rc->total);
+    }
+};
+
+/**
+ * a node of a binary search tree which knows its father.
+ * the value lives in the node, so a node is one allocation and a descent loads no extra pointer.
+ * h belongs to the balancing policy: a height, a color or a priority.
+ * Augment is kept up to date by tree_core, see no_augment.
+ */
+template<class Value, class Augment = no_augment>
+struct tree_node : Augment {
+    typedef Value value_type;
+    typedef Augment augment_type;
+
+    value_type data;
+    tree_node *father;
+    tree_node *lc, *rc;
+    int h;
+
+    tree_node(const value_type &v) : data(v) {
+        father = lc = rc = NULL;
+        h = 1;
+    }
+    /**
+     * builds the value in place from the key and the mapped value.
+     */
+    template<class K, class M>
+    tree_node(K &&k, M &&m) : data(std::forward<K>(k), std::forward<M>(m)) {
+        father = lc = rc = NULL;
+        h = 1;
+    }
+};
+
+/**
+ * the shape of a binary search tree: walking, rotating, unlinking, copying and freeing nodes.
+ * it knows nothing about keys. the owner decides where a node goes,
+ * a balancing policy decides how the tree is reshaped after that.
+ * nodes are only ever relinked, never copied, so pointers to them stay valid.
+ */
+template<class Node>
+class tree_core {
+public:
+    Node *root;
+    /**
+     * the first and the last node in order, NULL when empty.
+     * kept up to date by link(), unlink() and reset() so begin() and --end() are O(1).
+     */
+    Node *leftmost, *rightmost;
+
+    tree_core() : root(NULL), leftmost(NULL), rightmost(NULL) {}
+
+    /**
+     * recomputes the subtree information of t and of every node above it.
+     */
+    void pullUp(Node *t) {
+        if (!Node::augmented)
+            return;
+        for (; t != NULL; t = t->father)
+            Node::pull(t);
+    }
+
+    /**
+     * makes r (a whole tree, maybe NULL) the contents, without freeing the old ones.
+     */
+    void reset(Node *r = NULL) {
+        root = leftmost = rightmost = r;
+        if (r == NULL)
+            return;
+        while (leftmost->lc != NULL)
+            leftmost = leftmost->lc;
+        while (rightmost->rc != NULL)
+            rightmost = rightmost->rc;
+    }
+
+    bool islc(Node *t) const {
+        if (t == root)
+            return false;
+        return t->father->lc == t;
+    }
+
+    Node *prev(Node *t) const{
+        if (t->lc != NULL) {
+            t = t->lc;
+            while (t->rc != NULL) {
+                t = t->rc;
+            }
+            return t;
+        }
+        else {
+            while (islc(t) && t != root) {
+                t = t->father;
+            }
+            return t->father;
+        }
+    }
+
+    Node *next(Node *t) const{
+        if (t->rc != NULL) {
+            t = t->rc;
+            while (t->lc != NULL) {
+                t = t->lc;
+            }
+            return t;
+        }
+        else {
+            while (!islc(t) && t != root) {
+                t = t->father;
+            }
+            return t->father;
+        }
+    }
+
+    /**
+     * puts y where x was, as the child of x's father (or as root).
+     */
+    void replace(Node *x, Node *y) {
+        if (x->father == NULL)
+            root = y;
+        else if (x->father->lc == x)
+            x->father->lc = y;
+        else
+            x->father->rc = y;
+        if (y != NULL)
+            y->father = x->father;
+    }
+
+    /**
+     * x->rc takes the place of x, x becomes its left child.
+     * returns the new father of x.
+     */
+    Node *rotateLeft(Node *x) {
+        Node *y = x->rc;
+        replace(x, y);
+        x->rc = y->lc;
+        if (y->lc != NULL)
+            y->lc->father = x;
+        y->lc = x;
+        x->father = y;
+        Node::pull(x);
+        Node::pull(y);
+        return y;
+    }
+
+    Node *rotateRight(Node *x) {
+        Node *y = x->lc;
+        replace(x, y);
+        x->lc = y->rc;
+        if (y->rc != NULL)
+            y->rc->father = x;
+        y->rc = x;
+        x->father = y;
+        Node::pull(x);
+        Node::pull(y);
+        return y;
+    }
+
+    /**
+     * hangs the leaf t below fa, on the left if left; fa == NULL means the tree is empty.
+     */
+    void link(Node *t, Node *fa, bool left) {
+        t->father = fa;
+        if (fa == NULL) {
+            root = leftmost = rightmost = t;
+        }
+        else if (left) {
+            fa->lc = t;
+            if (fa == leftmost)
+                leftmost = t;
+        }
+        else {
+            fa->rc = t;
+            if (fa == rightmost)
+                rightmost = t;
+        }
+        pullUp(t);
+    }
+
+    /**
+     * takes z out of the tree without freeing it.
+     * if z has two children its successor is moved into its place and the two swap h,
+     * so afterwards z->h describes the position that really disappeared.
+     * x is the node (maybe NULL) now standing in that position and xp its father.
+     */
+    void unlink(Node *z, Node *&x, Node *&xp) {
+        if (z == leftmost)
+            leftmost = next(z);
+        if (z == rightmost)
+            rightmost = prev(z);
+
+        if (z->lc == NULL || z->rc == NULL) {
+            x = z->lc != NULL ? z->lc : z->rc;
+            xp = z->father;
+            replace(z, x);
+        }
+        else {
+            Node *y = z->rc;
+            while (y->lc != NULL)
+                y = y->lc;
+
+            x = y->rc;
+            if (y->father == z) {
+                xp = y;
+            }
+            else {
+                xp = y->father;
+                replace(y, x);
+                y->rc = z->rc;
+                y->rc->father = y;
+            }
+            replace(z, y);
+            y->lc = z->lc;
+            y->lc->father = y;
+
+            int h = y->h;
+            y->h = z->h;
+            z->h = h;
+        }
+        z->father = z->lc = z->rc = NULL;
+        pullUp(xp);
+    }
+
+    /**
+     * deletes the subtree of t, children before their father.
+     */
+    static void makeEmpty(Node *t) {
+        while (t != NULL) {
+            if (t->lc != NULL)
+                t = t->lc;
+            else if (t->rc != NULL)
+                t = t->rc;
+            else {
+                Node *fa = t->father;
+                if (fa != NULL) {
+                    if (fa->lc == t)
+                        fa->lc = NULL;
+                    else
+                        fa->rc = NULL;
+                }
+                delete t;
+                t = fa;
+            }
+        }
+    }
+
+    /**
+     * a copy of the tree under other with the same shape and the same h, built top-down in one walk.
+     */
+    static Node *copy(const Node *other) {
+        if (other == NULL)
+            return NULL;
+
+        Node *ret = clone(other);
+        Node *t = ret;
+        try {
+            while (true) {
+                if (other->lc != NULL && t->lc == NULL) {
+                    t->lc = clone(other->lc);
+                    t->lc->father = t;
+                    t = t->lc;
+                    other = other->lc;
+                }
+                else if (other->rc != NULL && t->rc == NULL) {
+                    t->rc = clone(other->rc);
+                    t->rc->father = t;
+                    t = t->rc;
+                    other = other->rc;
+                }
+                else if (t == ret) {
+                    break;
+                }
+                else {
+                    t = t->father;
+                    other = other->father;
+                }
+            }
+        }
+        catch (...) {
+            makeEmpty(ret);
+            throw;
+        }
+        return ret;
+    }
+
+    /**
+     * the height of a tree of n nodes built by build(): the number of bits in n.
+     */
+    static int levels(size_t n) {
+        int ret = 0;
+        for (; n != 0; n >>= 1)
+            ++ret;
+        return ret;
+    }
+
+    /**
+     * a tree of the n nodes returned by make(), which come in order; returns its root.
+     * the two subtrees of every node differ in size by at most one, so every level but the last is full.
+     * nothing is compared and nothing rotated: the nodes are made and linked in order,
+     * keeping the unfinished ones on a stack, then Balance::built(t, depth, height, levels) sets their h.
+     * the links of the nodes make() returns are overwritten, so they may be reused ones.
+     * if make() throws, the nodes made so far are deleted.
+     */
+    template<class Balance, class Make>
+    static Node *build(size_t n, Make make) {
+        if (n == 0)
+            return NULL;
+
+        struct frame {
+            size_t lo, hi;
+            Node *t, *left;
+        } st[sizeof(size_t) * CHAR_BIT];
+        int k = 0;
+        int all = levels(n);
+        st[0].lo = 0;
+        st[0].hi = n;
+        st[0].t = st[0].left = NULL;
+        try {
+            while (true) {
+                frame &f = st[k];
+                size_t mid = f.lo + (f.hi - f.lo) / 2;
+                if (f.t == NULL) {
+                    if (f.lo < mid && f.left == NULL) {
+                        st[++k].lo = f.lo;
+                        st[k].hi = mid;
+                        st[k].t = st[k].left = NULL;
+                        continue;
+                    }
+                    Node *t = make();
+                    t->father = t->rc = NULL;
+                    t->lc = f.left;
+                    if (f.left != NULL)
+                        f.left->father = t;
+                    f.t = t;
+                    f.left = NULL;
+                    if (mid + 1 < f.hi) {
+                        st[++k].lo = mid + 1;
+                        st[k].hi = f.hi;
+                        st[k].t = st[k].left = NULL;
+                        continue;
+                    }
+                }
+
+                // both subtrees of f.t are in place
+                Node *t = f.t;
+                Balance::built(t, k, levels(f.hi - f.lo), all);
+                Node::pull(t);
+                if (k == 0)
+                    return t;
+                frame &p = st[--k];
+                if (p.t == NULL) {
+                    p.left = t;
+                }
+                else {
+                    p.t->rc = t;
+                    t->father = p.t;
+                }
+            }
+        }
+        catch (...) {
+            for (; k >= 0; --k)
+                makeEmpty(st[k].t != NULL ? st[k].t : st[k].left);
+            throw;
+        }
+    }
+
+private:
+    static Node *clone(const Node *other) {
+        Node *ret = new Node(other->data);
+        ret->h = other->h;
+        static_cast<typename Node::augment_type &>(*ret) = *other;
+        return ret;
+    }
+};
+
+/**
+ * balancing policies for tree_core. each one provides
+ *   inserted(t, x): x has just been linked in as a leaf;
+ *   erase(t, z):    unlink z from t (the caller frees it);
+ *   accessed(t, x): x has just been looked up through a non-const path;
+ *   built(x, depth, height, levels): x was placed by tree_core::build() at depth (0 for the root),
+ *                   its subtree is height high and the whole tree levels high.
+ */
+
+/**
+ * AVL: h is the height of the subtree, the heights of two siblings differ by at most one.
+ * the shallowest of the policies (height below 1.45 log2(n + 2)), so the best one for lookups.
+ */
+struct avl_balance {
+    template<class Node>
+    static int height(const Node *t) {
+        return t == NULL ? 0 : t->h;
+    }
+
+    template<class Node>
+    static void update(Node *t) {
+        int l = height(t->lc), r = height(t->rc);
+        t->h = (l > r ? l : r) + 1;
+    }
+
+    template<class Node>
+    static Node *rotateLeft(tree_core<Node> &tr, Node *x) {
+        Node *y = tr.rotateLeft(x);
+        update(x);
+        update(y);
+        return y;
+    }
+
+    template<class Node>
+    static Node *rotateRight(tree_core<Node> &tr, Node *x) {
+        Node *y = tr.rotateRight(x);
+        update(x);
+        update(y);
+        return y;
+    }
+
+    /**
+     * restores the AVL property on the path from t up to the root after t's subtree changed,
+     * stopping as soon as a subtree comes out with the height it had before.
+     */
+    template<class Node>
+    static void rebalance(tree_core<Node> &tr, Node *t) {
+        while (t != NULL) {
+            int old = t->h;
+            int bf = height(t->lc) - height(t->rc);
+            if (bf > 1) {
+                if (height(t->lc->lc) < height(t->lc->rc))
+                    rotateLeft(tr, t->lc);
+                t = rotateRight(tr, t);
+            }
+            else if (bf < -1) {
+                if (height(t->rc->rc) < height(t->rc->lc))
+                    rotateRight(tr, t->rc);
+                t = rotateLeft(tr, t);
+            }
+            else {
+                update(t);
+            }
+
+            if (t->h == old)
+                break;
+            t = t->father;
+        }
+    }
+
+    template<class Node>
+    static void inserted(tree_core<Node> &tr, Node *x) {
+        x->h = 1;
+        rebalance(tr, x->father);
+    }
+
+    template<class Node>
+    static void erase(tree_core<Node> &tr, Node *z) {
+        Node *x, *xp;
+        tr.unlink(z, x, xp);
+        rebalance(tr, xp);
+    }
+
+    template<class Node>
+    static void accessed(tree_core<Node> &, Node *) {}
+
+    template<class Node>
+    static void built(Node *x, int, int height, int) {
+        x->h = height;
+    }
+};
+
+/**
+ * red-black: h is the color. at most two rotations per insert and three per erase,
+ * the rest is recoloring, so it is the cheapest to update; the height stays below 2 log2(n + 1).
+ */
+struct rb_balance {
+    enum { red = 0, black = 1 };
+
+    template<class Node>
+    static bool isBlack(const Node *t) {
+        return t == NULL || t->h == black;
+    }
+
+    template<class Node>
+    static void inserted(tree_core<Node> &tr, Node *x) {
+        x->h = red;
+        while (x != tr.root && x->father->h == red) {
+            Node *p = x->father, *g = p->father;
+            if (p == g->lc) {
+                Node *u = g->rc;
+                if (!isBlack(u)) {
+                    p->h = u->h = black;
+                    g->h = red;
+                    x = g;
+                }
+                else {
+                    if (x == p->rc) {
+                        tr.rotateLeft(p);
+                        p = x;
+                    }
+                    p->h = black;
+                    g->h = red;
+                    tr.rotateRight(g);
+                    break;
+                }
+            }
+            else {
+                Node *u = g->lc;
+                if (!isBlack(u)) {
+                    p->h = u->h = black;
+                    g->h = red;
+                    x = g;
+                }
+                else {
+                    if (x == p->lc) {
+                        tr.rotateRight(p);
+                        p = x;
+                    }
+                    p->h = black;
+                    g->h = red;
+                    tr.rotateLeft(g);
+                    break;
+                }
+            }
+        }
+        tr.root->h = black;
+    }
+
+    template<class Node>
+    static void erase(tree_core<Node> &tr, Node *z) {
+        Node *x, *xp;
+        tr.unlink(z, x, xp);
+        if (z->h == red)
+            return;
+
+        // the subtree at x (on the xp side) is one black short
+        while (x != tr.root && isBlack(x)) {
+            if (x == xp->lc) {
+                Node *w = xp->rc;
+                if (!isBlack(w)) {
+                    w->h = black;
+                    xp->h = red;
+                    tr.rotateLeft(xp);
+                    w = xp->rc;
+                }
+                if (isBlack(w->lc) && isBlack(w->rc)) {
+                    w->h = red;
+                    x = xp;
+                    xp = x->father;
+                }
+                else {
+                    if (isBlack(w->rc)) {
+                        w->lc->h = black;
+                        w->h = red;
+                        w = tr.rotateRight(w);
+                    }
+                    w->h = xp->h;
+                    xp->h = black;
+                    w->rc->h = black;
+                    tr.rotateLeft(xp);
+                    x = tr.root;
+                }
+            }
+            else {
+                Node *w = xp->lc;
+                if (!isBlack(w)) {
+                    w->h = black;
+                    xp->h = red;
+                    tr.rotateRight(xp);
+                    w = xp->lc;
+                }
+                if (isBlack(w->lc) && isBlack(w->rc)) {
+                    w->h = red;
+                    x = xp;
+                    xp = x->father;
+                }
+                else {
+                    if (isBlack(w->lc)) {
+                        w->rc->h = black;
+                        w->h = red;
+                        w = tr.rotateLeft(w);
+                    }
+                    w->h = xp->h;
+                    xp->h = black;
+                    w->lc->h = black;
+                    tr.rotateRight(xp);
+                    x = tr.root;
+                }
+            }
+        }
+        if (x != NULL)
+            x->h = black;
+    }
+
+    template<class Node>
+    static void accessed(tree_core<Node> &, Node *) {}
+
+    /**
+     * every level but the last is full: all black with the last level red has the same
+     * number of black nodes on every path.
+     */
+    template<class Node>
+    static void built(Node *x, int depth, int, int levels) {
+        x->h = depth > 0 && depth == levels - 1 ? red : black;
+    }
+};
+
+/**
+ * treap: h is a priority and fathers outrank their children, so the shape is that of a
+ * random insertion order whatever the real one (expected height about 3 log2 n).
+ * the priority is a hash of the node's address, there is no generator state to share.
+ */
+struct treap_balance {
+    template<class Node>
+    static int priority(const Node *x) {
+        unsigned long long k = (unsigned long long)(size_t)x;
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return (int)(k >> 33);
+    }
+
+    template<class Node>
+    static void inserted(tree_core<Node> &tr, Node *x) {
+        x->h = priority(x);
+        while (x->father != NULL && x->father->h < x->h) {
+            if (x == x->father->lc)
+                tr.rotateRight(x->father);
+            else
+                tr.rotateLeft(x->father);
+        }
+    }
+
+    /**
+     * rotates z down below its higher-priority child until it has at most one child.
+     */
+    template<class Node>
+    static void erase(tree_core<Node> &tr, Node *z) {
+        while (z->lc != NULL && z->rc != NULL) {
+            if (z->lc->h > z->rc->h)
+                tr.rotateRight(z);
+            else
+                tr.rotateLeft(z);
+        }
+        Node *x, *xp;
+        tr.unlink(z, x, xp);
+    }
+
+    template<class Node>
+    static void accessed(tree_core<Node> &, Node *) {}
+
+    /**
+     * priorities falling with depth keep the built shape a heap; they sit at the top of the hashed range,
+     * so nodes inserted later almost always settle below the balanced skeleton.
+     */
+    template<class Node>
+    static void built(Node *x, int depth, int, int) {
+        x->h = INT_MAX - depth;
+    }
+};
+
+/**
+ * splay: every node inserted or looked up is rotated to the root, h is unused.
+ * O(log n) amortized per operation, and much less when a few keys get most of the lookups.
+ * a single operation may still walk a long path, but nothing here recurses.
+ */
+struct splay_balance {
+    template<class Node>
+    static void rotateUp(tree_core<Node> &tr, Node *x) {
+        if (x == x->father->lc)
+            tr.rotateRight(x->father);
+        else
+            tr.rotateLeft(x->father);
+    }
+
+    template<class Node>
+    static void splay(tree_core<Node> &tr, Node *x) {
+        while (x->father != NULL) {
+            Node *p = x->father, *g = p->father;
+            if (g == NULL) {
+                rotateUp(tr, x);
+            }
+            else if ((x == p->lc) == (p == g->lc)) {
+                rotateUp(tr, p);
+                rotateUp(tr, x);
+            }
+            else {
+                rotateUp(tr, x);
+                rotateUp(tr, x);
+            }
+        }
+    }
+
+    template<class Node>
+    static void inserted(tree_core<Node> &tr, Node *x) {
+        splay(tr, x);
+    }
+
+    template<class Node>
+    static void erase(tree_core<Node> &tr, Node *z) {
+        splay(tr, z);
+        Node *x, *xp;
+        tr.unlink(z, x, xp);
+    }
+
+    template<class Node>
+    static void accessed(tree_core<Node> &tr, Node *x) {
+        splay(tr, x);
+    }
+
+    template<class Node>
+    static void built(Node *, int, int, int) {}
+};
+
+}
+
+#endif